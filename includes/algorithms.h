@@ -1,20 +1,54 @@
-#ifndef ALGORITHMS_H
-#define ALGORITHMS_H
-
-#include "scheduler.h"
-
-void schedule_fifo(process_t *processes, int n, timeline_event_t *timeline, int *timeline_len);
-void schedule_sjf(process_t *processes, int n, timeline_event_t *timeline, int *timeline_len);
-void schedule_stcf(process_t *processes, int n, timeline_event_t *timeline, int *timeline_len);
-void schedule_rr(process_t *processes, int n, int quantum, timeline_event_t *timeline, int *timeline_len);
-
-typedef struct {
-    int num_queues;
-    int *quantums;              // Quantum for each queue (array of size num_queues)
-    int boost_interval;         // Priority boost every N time units (0 = off)
-} mlfq_config_t;
-
-void schedule_mlfq(process_t *processes, int n, mlfq_config_t *config, timeline_event_t *timeline, int *timeline_len);
-
-#endif // ALGORITHMS_H
-
+#ifndef ALGORITHMS_H
+#define ALGORITHMS_H
+
+#include <stdint.h>
+#include "scheduler.h"
+#include "process_store.h"
+#include "timeline.h"
+
+void schedule_fifo(process_store_t *ps, timeline_sink_t *timeline);
+void schedule_sjf(process_store_t *ps, timeline_sink_t *timeline);
+void schedule_stcf(process_store_t *ps, timeline_sink_t *timeline);
+void schedule_rr(process_store_t *ps, int quantum, timeline_sink_t *timeline);
+
+typedef struct {
+    int num_queues;
+    int *quantums;              // Quantum for each queue (array of size num_queues)
+    int boost_interval;         // Priority boost every N time units (0 = off)
+} mlfq_config_t;
+
+void schedule_mlfq(process_store_t *ps, mlfq_config_t *config, timeline_sink_t *timeline);
+
+typedef struct {
+    int preemptive;             // a better-priority arrival takes the CPU at once
+    int aging_interval;         // every N time units waiting processes move up one level (0 = off)
+} priority_config_t;
+
+void schedule_priority(process_store_t *ps, const priority_config_t *config, timeline_sink_t *timeline);
+
+/* Proportional share: tickets halve per priority level, 1024 at priority 0 down to 1 at 10 and below. */
+#define TICKETS_MAX 1024
+static inline int priority_tickets(int priority) {
+    if (priority <= 0) return TICKETS_MAX;
+    return priority >= 10 ? 1 : TICKETS_MAX >> priority;
+}
+
+#define LOTTERY_DEFAULT_SEED 1
+
+void schedule_lottery(process_store_t *ps, int quantum, uint64_t seed, timeline_sink_t *timeline);
+void schedule_stride(process_store_t *ps, int quantum, timeline_sink_t *timeline);
+
+/* CFS: priority p runs at nice p - 1 (priority 1 = nice 0, weight 1024), clamped to nice -20..19. */
+#define CFS_DEFAULT_LATENCY 24
+#define CFS_DEFAULT_GRANULARITY 3
+
+typedef struct {
+    int target_latency;         // period in which every runnable process should run once
+    int min_granularity;        // shortest slice; the period stretches to n * this under load
+} cfs_config_t;
+
+int cfs_weight(int priority);
+void schedule_cfs(process_store_t *ps, const cfs_config_t *config, timeline_sink_t *timeline);
+
+#endif // ALGORITHMS_H
+
@@ -0,0 +1,35 @@
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include <stdio.h>
+#include <stdint.h>
+
+/*
+ * Byte stream for engine checkpoints (see engine_checkpoint). Every value is
+ * a signed integer written as a zigzag LEB128 varint, so small counts and
+ * indices take one or two bytes. The stream keeps an FNV-1a hash of the
+ * bytes it moved, closed by a checksum at the end of the file, and a sticky
+ * error flag: callers read or write a whole section and test err once.
+ */
+#define CKPT_MAGIC   "SCHEDCK"
+#define CKPT_VERSION 1
+
+typedef struct ckpt_stream {
+    FILE *f;
+    uint64_t hash;              // FNV-1a of the bytes so far
+    int err;                    // set on I/O error, truncation or bad data
+} ckpt_stream_t;
+
+void ckpt_open(ckpt_stream_t *s, FILE *f);
+
+void      ckpt_put(ckpt_stream_t *s, long long v);
+long long ckpt_get(ckpt_stream_t *s);               // 0 once err is set
+
+/* Read a value that must lie in [lo, hi]; outside it sets err and returns lo. */
+long long ckpt_get_range(ckpt_stream_t *s, long long lo, long long hi);
+
+/* Raw bytes, for the magic and names. */
+void ckpt_put_bytes(ckpt_stream_t *s, const void *data, size_t len);
+void ckpt_get_bytes(ckpt_stream_t *s, void *data, size_t len);
+
+#endif // CHECKPOINT_H
@@ -0,0 +1,42 @@
+#ifndef COMPARE_H
+#define COMPARE_H
+
+#include "scheduler.h"
+#include "algorithms.h"
+#include "metrics.h"
+#include "policy.h"
+
+/*
+ * Comparison runner for the report: runs every registered policy (policy.h)
+ * with its report configuration on a private process store built from the
+ * workload, one thread per policy. Slots follow the registry order.
+ */
+#define COMPARE_NUM_ALGS POLICY_COUNT
+
+typedef struct {
+    const char *name;           // e.g. "FIFO"
+    metrics_t metrics;
+    sched_stats_t stats;        // filled only in SCHED_STATS builds
+    int precomputed;            // metrics already filled in by the caller, skip the run
+    int failed;                 // the run could not complete; metrics are not valid
+} compare_entry_t;
+
+/* Fill names and clear precomputed and failed flags for all COMPARE_NUM_ALGS entries. */
+void compare_init(compare_entry_t *entries);
+
+/*
+ * Report slot whose configuration matches a run the caller already did,
+ * or -1 if none does.
+ */
+int compare_find(const char *alg, const policy_params_t *params);
+
+/* Run slot's policy with the report configuration on ps. Returns engine_run's status. */
+int compare_run_slot(int slot, process_store_t *ps, timeline_sink_t *sink);
+
+/*
+ * Run every entry that is not precomputed, in parallel. processes is not modified.
+ * Returns 0, or -1 if any run failed; those entries have failed set.
+ */
+int run_comparison(const process_t *processes, int n, compare_entry_t *entries);
+
+#endif // COMPARE_H
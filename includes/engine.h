@@ -0,0 +1,146 @@
+#ifndef ENGINE_H
+#define ENGINE_H
+
+#include <stdint.h>
+#include "scheduler.h"
+#include "process_store.h"
+#include "algorithms.h"
+#include "timeline.h"
+#include "checkpoint.h"
+
+/*
+ * Shared event-driven simulation core. A policy only decides who runs and
+ * for how long; the engine owns the clock, the arrival cursor, idle gaps,
+ * timeline emission, completions and the generic counters (dispatches,
+ * queue traffic, preemptions, idle gaps, timeline events).
+ *
+ * A dispatch runs until the process completes or its slice is used up;
+ * preemptive policies also get a say at every arrival. Time jumps straight
+ * to the next of those events, and one timeline event is emitted per
+ * dispatch.
+ *
+ * A run can also be driven in steps (engine_start, engine_advance) and
+ * saved or restored between them (engine_checkpoint, engine_resume).
+ * With an arrival source (engine_start_stream) processes are not known up
+ * front: the source admits each one into a store slot when it arrives and
+ * takes the slot back when it completes (stream mode, see stream.h).
+ */
+#define SLICE_UNLIMITED ((sim_time_t)INT64_MAX)
+
+/* Parameters of every built-in policy; each policy reads only its own fields. */
+typedef struct {
+    int quantum;                // rr, lottery, stride
+    mlfq_config_t mlfq;         // mlfq (quantums owned by the caller)
+    priority_config_t prio;     // priority, ppriority
+    uint64_t seed;              // lottery
+    cfs_config_t cfs;           // cfs
+} policy_params_t;
+
+/*
+ * Policy callbacks. state is a zeroed block of state_size bytes, private to
+ * one run; idx is a process index into the store. NULL optional hooks are
+ * skipped.
+ */
+typedef struct {
+    const char *name;
+    size_t state_size;
+    // allocate queues; start is the first arrival time. Returns 0 or -1.
+    int  (*init)(void *state, process_store_t *ps, const policy_params_t *params, sim_time_t start);
+    void (*destroy)(void *state);
+    // idx arrived at time and is runnable
+    void (*enqueue)(void *state, int idx, sim_time_t time);
+    // choose and dequeue the next process, or -1 if none is runnable
+    int  (*pick_next)(void *state, sim_time_t time);
+    // CPU time idx may use from now before it must give the CPU back (SLICE_UNLIMITED = to completion);
+    // asked at dispatch and again whenever idx survives a preempt check
+    sim_time_t (*slice)(void *state, int idx, sim_time_t time);
+    // optional: after arrivals at time, should the running idx yield? (NULL = non-preemptive)
+    int  (*preempt)(void *state, int idx, sim_time_t time);
+    // optional: idx just ran for ran time units, before arrivals up to time are queued
+    void (*on_tick)(void *state, int idx, sim_time_t ran, sim_time_t time);
+    // idx stopped unfinished (slice used up or preempted) after a dispatch of ran time units
+    void (*requeue)(void *state, int idx, sim_time_t ran, sim_time_t time);
+    // optional: idx completed at time
+    void (*on_complete)(void *state, int idx, sim_time_t time);
+    // optional, needed for checkpoints: write the queues and policy clocks; load reads them
+    // back into a freshly initialized state of n processes, setting in->err on bad data
+    void (*save)(const void *state, ckpt_stream_t *out);
+    void (*load)(void *state, int n, ckpt_stream_t *in);
+    // optional, needed for streamed runs: the store grew to ps->n slots and hot may have moved;
+    // resize and rebind per-process state. Returns 0 or -1.
+    int  (*grow)(void *state, process_store_t *ps);
+} sched_policy_t;
+
+/*
+ * Arrivals of a streamed run, in arrival order. admit puts the next process
+ * in a free slot of ps, first growing ps->n (by process_store_reserve) if no
+ * slot is free; retire is called once the process in idx has completed and
+ * its results are filled in, after which the slot may be reused.
+ */
+typedef struct engine_source {
+    sim_time_t (*peek)(struct engine_source *src);     // next arrival time, -1 if none is left
+    int  (*admit)(struct engine_source *src, process_store_t *ps);     // its slot, -1 on error
+    void (*retire)(struct engine_source *src, process_store_t *ps, int idx, sim_time_t time);
+} engine_source_t;
+
+/*
+ * Reset the store and simulate it under policy, emitting into timeline and
+ * flushing it before returning. Returns 0, or -1 on allocation failure.
+ */
+int engine_run(process_store_t *ps, const sched_policy_t *policy, const policy_params_t *params,
+               timeline_sink_t *timeline);
+
+/* A run in progress: the policy state plus the engine's own clock and cursors. */
+typedef struct {
+    process_store_t *ps;
+    const sched_policy_t *policy;
+    void *state;
+    engine_source_t *source;    // streamed run, NULL for a fixed store
+    int *order;                 // processes by arrival (fixed store only)
+    int next;                   // arrival cursor into order[]
+    int completed;
+    int cur;                    // running process, -1 if none
+    sim_time_t time;
+    sim_time_t cur_start;       // start of its dispatch
+    sim_time_t budget;          // slice left
+    int done;
+} engine_t;
+
+/* Reset the store and set up a run at the first arrival. Returns 0, or -1 on allocation failure. */
+int  engine_start(engine_t *e, process_store_t *ps, const sched_policy_t *policy, const policy_params_t *params);
+
+/*
+ * Same, for processes that come from source instead of the store, which
+ * starts empty (n = 0). The policy needs a grow hook. Returns 0 or -1.
+ */
+int  engine_start_stream(engine_t *e, process_store_t *ps, const sched_policy_t *policy,
+                         const policy_params_t *params, engine_source_t *source);
+
+/*
+ * Simulate up to the first scheduling point at or after until (a dispatch
+ * in progress is not cut short), emitting into timeline and flushing it.
+ * Returns 1 once every process has completed, 0 if paused before that,
+ * -1 if a streamed arrival could not be admitted.
+ */
+int  engine_advance(engine_t *e, sim_time_t until, timeline_sink_t *timeline);
+void engine_free(engine_t *e);
+
+/*
+ * Checkpoint file (ckpt_stream_t varints):
+ *   magic "SCHEDCK\0", version, policy name, n, workload fingerprint
+ *   clock and cursors, timeline cursor (events, total time), counters
+ *   per process: work done, start time, completion time
+ *   policy section (its save hook), checksum
+ * Parameters are not stored: engine_resume takes them again, so a shared
+ * prefix can be continued under, say, a different quantum. Resuming needs
+ * the same workload and policy; completed processes are recorded again in
+ * the store's metrics accumulator, if any. The timeline sink's counters are
+ * restored, but not the events emitted before the checkpoint. Streamed runs
+ * cannot be checkpointed.
+ * Both return 0, or -1 with a message on stderr.
+ */
+int engine_checkpoint(const engine_t *e, const timeline_sink_t *timeline, FILE *out);
+int engine_resume(engine_t *e, process_store_t *ps, const sched_policy_t *policy,
+                  const policy_params_t *params, timeline_sink_t *timeline, FILE *in);
+
+#endif // ENGINE_H
@@ -0,0 +1,48 @@
+#ifndef GANTT_INDEX_H
+#define GANTT_INDEX_H
+
+#include "scheduler.h"
+
+/*
+ * Multi-resolution index over a single-CPU timeline for the Gantt view.
+ * Time is cut into a power-of-two number of leaf buckets (at most
+ * GANTT_MAX_LEAVES, one time unit each when the span allows) and a segment
+ * tree keeps, per node, the busy time and the dominant pid (a mergeable
+ * weighted-majority summary). Sampling a view into w screen columns costs
+ * O(w log leaves) however many events the timeline holds; views with only
+ * a few events per column are drawn exactly from the events instead.
+ * Events must be in time order and must not overlap.
+ */
+#define GANTT_MAX_LEAVES (1 << 18)
+
+typedef struct {
+    sim_time_t busy;            // non-idle time
+    sim_time_t weight;          // majority summary: pid leads by this much
+    int pid;                    // dominant pid, -1 if none
+} gantt_node_t;
+
+typedef struct {
+    const timeline_event_t *events;     // not owned
+    int len;
+    sim_time_t origin;          // start of the first event
+    sim_time_t end;             // end of the last event
+    sim_time_t leaf_width;      // time units per leaf
+    int leaves;                 // power of two
+    gantt_node_t *tree;         // 2 * leaves nodes, root at 1, leaf i at leaves + i
+} gantt_index_t;
+
+/* One screen column. */
+typedef struct {
+    int pid;                    // dominant pid, -1 if the column is idle
+    sim_time_t busy;            // busy time inside the column
+    sim_time_t span;            // time the column covers
+} gantt_cell_t;
+
+/* Build the index in O(len + leaves). Returns 0, or -1 on allocation failure. */
+int  gantt_index_build(gantt_index_t *g, const timeline_event_t *events, int len);
+void gantt_index_free(gantt_index_t *g);
+
+/* Summarize [t0, t1) into width columns. */
+void gantt_index_sample(const gantt_index_t *g, sim_time_t t0, sim_time_t t1, int width, gantt_cell_t *cells);
+
+#endif // GANTT_INDEX_H
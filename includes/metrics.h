@@ -1,18 +1,76 @@
-#ifndef METRICS_H
-#define METRICS_H
-
-#include "scheduler.h"
-
-typedef struct {
-    double avg_turnaround_time;
-    double avg_waiting_time;
-    double avg_response_time;
-    double cpu_utilization;
-    double throughput;
-    double fairness_index;      // Jain's fairness index
-} metrics_t;
-
-void calculate_metrics(process_t *processes, int n, int total_time, metrics_t *metrics);
-
-#endif // METRICS_H
-
+#ifndef METRICS_H
+#define METRICS_H
+
+#include "scheduler.h"
+#include "process_store.h"
+
+/* Tail of one latency series over completed processes (nearest-rank percentiles). */
+typedef struct {
+    double p50;
+    double p90;
+    double p99;
+    double p999;
+    double max;
+} latency_tail_t;
+
+typedef struct {
+    double avg_turnaround_time;
+    double avg_waiting_time;
+    double avg_response_time;
+    double cpu_utilization;
+    double throughput;
+    double fairness_index;      // Jain's fairness index
+    latency_tail_t turnaround;
+    latency_tail_t waiting;
+    latency_tail_t response;
+} metrics_t;
+
+/*
+ * Log-bucketed latency histogram (HDR-style). Values below 2^LATENCY_HIST_SUB_BITS
+ * get a bucket each; above that every power of two is split into
+ * 2^LATENCY_HIST_SUB_BITS buckets, so a percentile read back is within 1% of
+ * the true value at any magnitude, in fixed memory.
+ */
+#define LATENCY_HIST_SUB_BITS 7
+#define LATENCY_HIST_BUCKETS ((64 - LATENCY_HIST_SUB_BITS) << LATENCY_HIST_SUB_BITS)
+
+typedef struct {
+    long long *counts;          // LATENCY_HIST_BUCKETS entries
+    long long total;
+    sim_time_t max;
+} latency_hist_t;
+
+/*
+ * Incremental metrics, fed one completed process at a time through
+ * process_store_complete (running sums plus one histogram per latency).
+ * No pass over the process array is needed afterwards, and a snapshot can
+ * be taken at any point of a run.
+ */
+typedef struct metrics_acc {
+    long long completed;
+    sim_time_t busy;            // CPU time of completed processes
+    sim_time_t sum_turnaround;
+    sim_time_t sum_waiting;
+    sim_time_t sum_response;
+    double sum_turnaround_sq;   // for the fairness index
+    latency_hist_t turnaround;
+    latency_hist_t waiting;
+    latency_hist_t response;
+} metrics_acc_t;
+
+int  metrics_acc_init(metrics_acc_t *acc);      // 0 on success, -1 if out of memory
+void metrics_acc_reset(metrics_acc_t *acc);
+void metrics_acc_free(metrics_acc_t *acc);
+void metrics_acc_record(metrics_acc_t *acc, sim_time_t turnaround, sim_time_t waiting,
+                        sim_time_t response, sim_time_t burst);
+
+/*
+ * Metrics of everything recorded so far. total_time is the simulated time
+ * elapsed; utilization counts the work of completed processes only.
+ */
+void metrics_acc_snapshot(const metrics_acc_t *acc, sim_time_t total_time, metrics_t *metrics);
+
+/* Fills turnaround, waiting and response time of each process in ps->cold and the averages in metrics. */
+void calculate_metrics(process_store_t *ps, sim_time_t total_time, metrics_t *metrics);
+
+#endif // METRICS_H
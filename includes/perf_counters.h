@@ -0,0 +1,41 @@
+#ifndef PERF_COUNTERS_H
+#define PERF_COUNTERS_H
+
+/*
+ * Hardware performance counters around a region of code, via Linux
+ * perf_event_open (user space only). Any counter the kernel, the CPU or the
+ * permissions (kernel.perf_event_paranoid) refuse is simply left out; on other
+ * systems none are available and every read reports -1.
+ */
+typedef enum {
+    PERF_CYCLES,
+    PERF_INSTRUCTIONS,
+    PERF_L1D_MISSES,            // L1 data cache read misses
+    PERF_LLC_MISSES,            // last level cache misses
+    PERF_BRANCH_MISSES,
+    PERF_NUM_COUNTERS
+} perf_counter_id_t;
+
+typedef struct {
+    int fd[PERF_NUM_COUNTERS];  // -1 = unavailable
+    int available;              // counters that opened
+} perf_counters_t;
+
+/* Open every counter it can, stopped. Returns how many opened (0 = none, the caller can carry on). */
+int perf_counters_open(perf_counters_t *pc);
+
+/* Zero and start all open counters. */
+void perf_counters_start(perf_counters_t *pc);
+
+/*
+ * Stop the counters and store their counts in values[PERF_NUM_COUNTERS],
+ * scaled up if the kernel had to multiplex them, or -1 for unavailable ones.
+ */
+void perf_counters_stop(perf_counters_t *pc, double *values);
+
+void perf_counters_close(perf_counters_t *pc);
+
+/* Short name for reports, e.g. "cycles". */
+const char *perf_counter_name(perf_counter_id_t id);
+
+#endif // PERF_COUNTERS_H
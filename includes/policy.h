@@ -0,0 +1,45 @@
+#ifndef POLICY_H
+#define POLICY_H
+
+#include <stdio.h>
+#include "scheduler.h"
+#include "engine.h"
+
+/*
+ * Registry of the single-CPU policies: command-line name, report name,
+ * argument parser and the configuration the comparison report uses. The
+ * registry order is the report order.
+ */
+#define POLICY_COUNT 10
+
+typedef struct {
+    const char *name;           // command-line name, e.g. "rr"
+    const char *report_name;    // e.g. "RR"
+    const char *usage;          // parameters after the name, e.g. "<quantum>"
+    int max_args;               // most parameters parse reads; anything after them is the caller's
+    const sched_policy_t *ops;
+    // fill params from the arguments after the name; returns 0 or an exit code (message printed)
+    int (*parse)(int argc, char **argv, policy_params_t *params);
+    policy_params_t report;     // configuration used in the comparison report
+} policy_entry_t;
+
+/* Built-in policies (algorithms.c). */
+extern const sched_policy_t policy_fifo, policy_sjf, policy_stcf, policy_rr, policy_mlfq,
+                            policy_priority, policy_ppriority, policy_lottery, policy_stride, policy_cfs;
+
+/* Entry at slot 0..POLICY_COUNT-1. */
+const policy_entry_t *policy_get(int slot);
+
+/* Slot of a command-line name, or -1. */
+int policy_find(const char *name);
+
+/* Same configuration: compares every field, MLFQ quantums by value. */
+int policy_params_equal(const policy_params_t *a, const policy_params_t *b);
+
+/* Parse "<num_q> <comma_quants> <boost_interval>" at args[0..2] into a malloc'd quantums array; returns 0 or an exit code. */
+int policy_parse_mlfq(char **args, mlfq_config_t *cfg);
+
+/* One "name usage" line per policy, each prefixed by indent. */
+void policy_print_usage(FILE *out, const char *indent);
+
+#endif // POLICY_H
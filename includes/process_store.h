@@ -0,0 +1,55 @@
+#ifndef PROCESS_STORE_H
+#define PROCESS_STORE_H
+
+#include "scheduler.h"
+#include "sched_stats.h"
+
+/*
+ * Process state as the schedulers see it, split by access pattern.
+ * hot[] is what every scheduling decision reads (queue keys, remaining
+ * time); it is 32 bytes per process, two to a cache line. cold[] holds
+ * results that are written about once per process. Both are indexed like
+ * the process_t array the store was built from.
+ */
+typedef struct {
+    sim_time_t arrival_time;
+    sim_time_t burst_time;
+    sim_time_t remaining_time;
+    int pid;
+    int priority;
+} process_hot_t;
+
+typedef struct {
+    sim_time_t start_time;      // -1 if never scheduled
+    sim_time_t completion_time; // -1 until finished
+    sim_time_t turnaround_time;
+    sim_time_t waiting_time;
+    sim_time_t response_time;
+    int finished;
+} process_cold_t;
+
+struct metrics_acc;
+
+typedef struct {
+    process_hot_t *hot;
+    process_cold_t *cold;
+    int n;                      // processes in use
+    int capacity;               // slots allocated in hot[] and cold[]
+    struct metrics_acc *acc;    // optional, fed by process_store_complete (NULL = none)
+    sched_stats_t *stats;       // optional instrumentation, see sched_stats.h (NULL = none)
+} process_store_t;
+
+/* Copy pid, arrival, burst and priority of each process in. Returns 0 or -1. */
+int  process_store_init(process_store_t *ps, const process_t *processes, int n);
+int  process_store_reserve(process_store_t *ps, int capacity);    // grow, keeping contents
+void process_store_reset(process_store_t *ps);                    // clear scheduling state (and acc, stats)
+void process_store_reset_one(process_store_t *ps, int idx);
+void process_store_free(process_store_t *ps);
+
+/* Mark idx finished at time: fills its completion, turnaround, waiting and response time and records it in acc. */
+void process_store_complete(process_store_t *ps, int idx, sim_time_t time);
+
+/* Copy scheduling results back into a process_t array of the same order. */
+void process_store_export(const process_store_t *ps, process_t *processes);
+
+#endif // PROCESS_STORE_H
@@ -0,0 +1,171 @@
+#ifndef READY_QUEUE_H
+#define READY_QUEUE_H
+
+#include <stdint.h>
+#include "scheduler.h"
+#include "process_store.h"
+
+/*
+ * Indexed binary min-heap of process indices.
+ * pos[idx] tracks where process idx sits in the heap (-1 if not queued),
+ * so a queued process can be re-keyed or removed in O(log n).
+ */
+typedef int (*rq_cmp_fn)(const process_hot_t *a, const process_hot_t *b);
+
+typedef struct {
+    int *heap;                  // process indices, heap[0] is the minimum
+    int *pos;                   // slot of each process index in heap (-1 if absent)
+    int size;
+    int capacity;               // number of processes (max queued at once)
+    process_hot_t *hot;         // keys of the indexed processes
+    rq_cmp_fn cmp;
+    const long long *key;       // rq_init_keyed: per-process key, ties by index (cmp unused)
+    long long comparisons;      // only counted when built with SCHED_STATS
+} ready_queue_t;
+
+int  rq_init(ready_queue_t *rq, process_hot_t *hot, int n, rq_cmp_fn cmp);
+int  rq_init_keyed(ready_queue_t *rq, process_hot_t *hot, int n, const long long *key);
+int  rq_reserve(ready_queue_t *rq, process_hot_t *hot, int capacity);    // grow, or rebind after hot moved
+void rq_free(ready_queue_t *rq);
+void rq_push(ready_queue_t *rq, int idx);
+int  rq_pop(ready_queue_t *rq);             // -1 if empty
+int  rq_peek(const ready_queue_t *rq);      // -1 if empty
+void rq_update(ready_queue_t *rq, int idx); // restore order after idx's key changed
+void rq_remove(ready_queue_t *rq, int idx);
+
+static inline int rq_empty(const ready_queue_t *rq) { return rq->size == 0; }
+static inline int rq_contains(const ready_queue_t *rq, int idx) { return rq->pos[idx] >= 0; }
+
+/*
+ * FIFO of process indices threaded through a caller-owned link[] array (one
+ * slot per process). A process sits in at most one list, so lists never
+ * overflow, and a whole list can be spliced onto another in O(1).
+ */
+typedef struct {
+    int head;                   // -1 if empty
+    int tail;
+} index_list_t;
+
+static inline void ilist_init(index_list_t *l) { l->head = l->tail = -1; }
+static inline int ilist_empty(const index_list_t *l) { return l->head == -1; }
+
+static inline void ilist_push(index_list_t *l, int *link, int idx) {
+    link[idx] = -1;
+    if (l->tail == -1) l->head = idx;
+    else link[l->tail] = idx;
+    l->tail = idx;
+}
+
+static inline int ilist_pop(index_list_t *l, int *link) {
+    int idx = l->head;
+    l->head = link[idx];
+    if (l->head == -1) l->tail = -1;
+    return idx;
+}
+
+/* Append all of src to the tail of dst, leaving src empty. */
+static inline void ilist_splice(index_list_t *dst, index_list_t *src, int *link) {
+    if (src->head == -1) return;
+    if (dst->tail == -1) dst->head = src->head;
+    else link[dst->tail] = src->head;
+    dst->tail = src->tail;
+    src->head = src->tail = -1;
+}
+
+/*
+ * Bucketed priority queue in the style of the Linux O(1) scheduler: one FIFO
+ * per priority level and a bitmap of the non-empty ones, so push, pop and
+ * finding the best level are O(1). Bucket 0 is the highest priority.
+ */
+#define PRIO_BUCKETS 64
+
+typedef struct {
+    index_list_t bucket[PRIO_BUCKETS];
+    uint64_t bitmap;            // bit b set = bucket b non-empty
+    int *link;                  // one slot per process
+} prio_queue_t;
+
+int  pq_init(prio_queue_t *pq, int n);
+void pq_free(prio_queue_t *pq);
+
+/* Aging: move every queued process up k buckets (bucket 0 absorbs the rest), keeping FIFO order. O(PRIO_BUCKETS). */
+void pq_age(prio_queue_t *pq, int k);
+
+/* Bucket of a process priority (lower = better); out-of-range priorities are clamped. */
+static inline int prio_bucket(int priority) {
+    return priority < 0 ? 0 : (priority >= PRIO_BUCKETS ? PRIO_BUCKETS - 1 : priority);
+}
+
+static inline int pq_empty(const prio_queue_t *pq) { return pq->bitmap == 0; }
+
+/* Highest-priority non-empty bucket, or -1. */
+static inline int pq_best(const prio_queue_t *pq) {
+    return pq->bitmap ? __builtin_ctzll(pq->bitmap) : -1;
+}
+
+static inline void pq_push(prio_queue_t *pq, int idx, int bucket) {
+    ilist_push(&pq->bucket[bucket], pq->link, idx);
+    pq->bitmap |= 1ULL << bucket;
+}
+
+static inline int pq_pop(prio_queue_t *pq) {
+    int b = pq_best(pq);
+    if (b < 0) return -1;
+    int idx = ilist_pop(&pq->bucket[b], pq->link);
+    if (ilist_empty(&pq->bucket[b])) pq->bitmap &= ~(1ULL << b);
+    return idx;
+}
+
+/*
+ * Fenwick tree of ticket counts indexed by process: O(log n) updates and
+ * weighted draws, for lottery scheduling. Processes start with 0 tickets.
+ */
+typedef struct {
+    long long *tree;            // 1-based partial sums
+    int n;
+    int top;                    // highest power of two <= n
+    long long total;
+} ticket_tree_t;
+
+int  tt_init(ticket_tree_t *tt, int n);
+void tt_free(ticket_tree_t *tt);
+void tt_add(ticket_tree_t *tt, int idx, long long delta);
+int  tt_find(const ticket_tree_t *tt, long long r);     // process holding ticket r, 0 <= r < total
+long long tt_get(const ticket_tree_t *tt, int idx);     // tickets held by idx, O(log n)
+
+/*
+ * Red-black tree of process indices ordered by (key[idx], idx), with the
+ * leftmost node cached: insert and remove are O(log n), first is O(1).
+ * Nodes live in per-process arrays; slot n is the shared black sentinel.
+ */
+typedef struct {
+    int *left, *right, *parent;
+    char *red;
+    const long long *key;       // caller-owned, must not change while idx is in the tree
+    int nil;                    // sentinel index (= n)
+    int root;
+    int first;                  // leftmost node, nil if empty
+    int size;
+    long long comparisons;      // only counted when built with SCHED_STATS
+} rb_tree_t;
+
+int  rbt_init(rb_tree_t *t, int n, const long long *key);
+void rbt_free(rb_tree_t *t);
+void rbt_insert(rb_tree_t *t, int idx);
+void rbt_remove(rb_tree_t *t, int idx);
+int  rbt_items(const rb_tree_t *t, int *out);   // queued indices in order into out[size]; returns size
+
+static inline int rbt_empty(const rb_tree_t *t) { return t->size == 0; }
+static inline int rbt_first(const rb_tree_t *t) { return t->size ? t->first : -1; }
+
+/* Comparators: (burst, arrival, pid) and (remaining, arrival, pid) */
+int rq_cmp_burst(const process_hot_t *a, const process_hot_t *b);
+int rq_cmp_remaining(const process_hot_t *a, const process_hot_t *b);
+
+/*
+ * Arrival cursor: indices sorted by (arrival_time, index), so ties keep
+ * the order of the input file. Caller frees the returned array.
+ */
+int *arrival_order(const process_hot_t *hot, int n);
+
+#endif // READY_QUEUE_H
@@ -0,0 +1,51 @@
+#ifndef REPLICATE_H
+#define REPLICATE_H
+
+#include <stdint.h>
+#include "scheduler.h"
+#include "metrics.h"
+#include "compare.h"
+#include "workload_gen.h"
+
+/*
+ * Monte Carlo replications: replication i generates a synthetic workload with
+ * seed base_seed + i and runs every selected report policy on it. Replications
+ * are spread over a thread pool, but each result has its own slot and the
+ * statistics are folded in replication order, so the output is the same for
+ * any thread count.
+ */
+typedef struct {
+    int replications;           // >= 2 for a confidence interval
+    workload_gen_config_t workload; // shape of every workload; workload.seed is the base seed
+    int selected[COMPARE_NUM_ALGS]; // nonzero = simulate this report slot
+    int threads;                // worker threads (<= 0: one per online CPU)
+} replicate_config_t;
+
+/* Sample mean with the half-width of its 95% confidence interval (Student t). */
+typedef struct {
+    double mean;
+    double half_width;
+} replicate_ci_t;
+
+typedef struct {
+    const char *policy;         // report name, e.g. "RR"
+    replicate_ci_t avg_turnaround;
+    replicate_ci_t avg_waiting;
+    replicate_ci_t avg_response;
+    replicate_ci_t p99_turnaround;
+    replicate_ci_t cpu_utilization;
+    replicate_ci_t throughput;
+    replicate_ci_t fairness;
+} replicate_summary_t;
+
+/*
+ * Run the replications and summarize each selected policy, in report order,
+ * into summaries[COMPARE_NUM_ALGS]. Returns the number of summaries, or -1 on error.
+ */
+int run_replications(const replicate_config_t *config, replicate_summary_t *summaries);
+
+/* Write summaries as CSV, or as a Markdown table when path ends in ".md". Returns 0 on success. */
+int write_replications(const char *path, const replicate_config_t *config,
+                       const replicate_summary_t *summaries, int count);
+
+#endif // REPLICATE_H
@@ -1,6 +1,6 @@
-#!/bin/bash
-for t in build/test_fifo build/test_sjf build/test_stcf build/test_rr build/test_mlfq; do
-    echo "Running $t ..."
-    $t
-    echo ""
-done
+#!/bin/bash
+for t in build/test_fifo build/test_sjf build/test_stcf build/test_rr build/test_mlfq build/test_ready_queue build/test_timeline build/test_metrics build/test_smp build/test_replicate build/test_priority build/test_lottery build/test_cfs build/test_engine build/test_gantt build/test_checkpoint; do
+    echo "Running $t ..."
+    $t
+    echo ""
+done
@@ -0,0 +1,31 @@
+#ifndef SCHED_STATS_H
+#define SCHED_STATS_H
+
+/*
+ * Instrumentation counters for one schedule_* call, to explain why a policy
+ * is slow or thrashes on a trace. Compiled out by default: build with
+ * -DSCHED_STATS (make STATS=1) to have the schedulers fill the struct
+ * attached to their process store. Otherwise SCHED_COUNT expands to
+ * nothing and the counters stay zero.
+ */
+typedef struct {
+    long long dispatches;       // a process was given the CPU
+    long long queue_pushes;     // ready queue insertions (arrivals and requeues)
+    long long queue_pops;
+    long long candidate_scans;  // heap comparisons, queue levels or entries examined to pick
+    long long preemptions;      // a process lost the CPU before finishing
+    long long idle_gaps;
+    long long demotions;        // MLFQ: moved to a lower queue
+    long long boosts;           // MLFQ: priority boosts performed
+    long long timeline_events;
+} sched_stats_t;
+
+#ifdef SCHED_STATS
+#define SCHED_STATS_ENABLED 1
+#define SCHED_COUNT(stats, field, k) do { if (stats) (stats)->field += (k); } while (0)
+#else
+#define SCHED_STATS_ENABLED 0
+#define SCHED_COUNT(stats, field, k) do { (void)(stats); (void)sizeof(k); } while (0)
+#endif
+
+#endif // SCHED_STATS_H
@@ -1,27 +1,30 @@
-#ifndef SCHEDULER_H
-#define SCHEDULER_H
-
-#include <stddef.h>
-
-typedef struct {
-    int pid;                    // Process ID
-    int arrival_time;           // When process arrives
-    int burst_time;             // Total CPU time needed
-    int priority;               // Priority (lower = higher priority)
-    int remaining_time;         // Time left to execute
-    int start_time;             // First time scheduled (-1 if never)
-    int completion_time;        // When finished
-    int turnaround_time;        // completion - arrival
-    int waiting_time;           // turnaround - burst
-    int response_time;          // start - arrival
-    int finished;               // boolean flag
-} process_t;
-
-typedef struct {
-    int time;                   // Time slice start
-    int pid;                    // Process running (-1 for idle)
-    int duration;               // How long it ran
-} timeline_event_t;
-
-#endif // SCHEDULER_H
-
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <stddef.h>
+
+/* Simulated time. 64-bit so long traces cannot overflow completion or total time. */
+typedef long long sim_time_t;
+
+typedef struct {
+    int pid;                    // Process ID
+    sim_time_t arrival_time;    // When process arrives
+    sim_time_t burst_time;      // Total CPU time needed
+    int priority;               // Priority (lower = higher priority)
+    sim_time_t remaining_time;  // Time left to execute
+    sim_time_t start_time;      // First time scheduled (-1 if never)
+    sim_time_t completion_time; // When finished
+    sim_time_t turnaround_time; // completion - arrival
+    sim_time_t waiting_time;    // turnaround - burst
+    sim_time_t response_time;   // start - arrival
+    int finished;               // boolean flag
+} process_t;
+
+typedef struct {
+    sim_time_t time;            // Time slice start
+    int pid;                    // Process running (-1 for idle)
+    sim_time_t duration;        // How long it ran
+    int core;                   // CPU it ran on (always 0 outside SMP mode)
+} timeline_event_t;
+
+#endif // SCHEDULER_H
@@ -0,0 +1,53 @@
+#ifndef SMP_H
+#define SMP_H
+
+#include "scheduler.h"
+#include "process_store.h"
+#include "algorithms.h"
+#include "timeline.h"
+
+/*
+ * Multi-CPU (SMP) simulation. Every core has its own run queue (one per MLFQ
+ * level); an arriving process goes to the core with the fewest unfinished
+ * processes assigned, and a core that runs dry steals the newest entry from
+ * the busiest queue. Timeline events carry the core they ran on.
+ */
+#define SMP_MAX_CORES 256
+
+typedef enum {
+    SMP_FIFO,
+    SMP_RR,
+    SMP_MLFQ
+} smp_policy_t;
+
+typedef struct {
+    int num_cores;              // 1..SMP_MAX_CORES
+    smp_policy_t policy;
+    int quantum;                // SMP_RR
+    const mlfq_config_t *mlfq;  // SMP_MLFQ, per-core queues with a global boost clock
+    int steal;                  // work stealing on (1) or static placement only (0)
+} smp_config_t;
+
+typedef struct {
+    int num_cores;
+    sim_time_t elapsed;         // first arrival to last completion
+    sim_time_t busy[SMP_MAX_CORES];
+    long long dispatches[SMP_MAX_CORES];
+    double utilization[SMP_MAX_CORES];  // % of elapsed each core was busy
+    double aggregate_utilization;       // % over all cores
+    long long migrations;       // dispatches on a different core than the previous slice
+    long long steals;
+    double imbalance;           // max core busy / mean core busy - 1 (0 = perfectly even)
+} smp_stats_t;
+
+/* Parse "fifo", "rr" or "mlfq". Returns 0, or -1 for other names. */
+int smp_policy_from_name(const char *name, smp_policy_t *policy);
+
+/*
+ * Simulate the store on config->num_cores cores, emitting per-core events to
+ * timeline and filling stats. Returns 0, or -1 on a bad config or allocation failure.
+ */
+int schedule_smp(process_store_t *ps, const smp_config_t *config, timeline_sink_t *timeline,
+                 smp_stats_t *stats);
+
+#endif // SMP_H
@@ -0,0 +1,41 @@
+#ifndef STREAM_H
+#define STREAM_H
+
+#include <stdio.h>
+#include "scheduler.h"
+#include "algorithms.h"
+#include "metrics.h"
+#include "policy.h"
+#include "timeline.h"
+#include "workload.h"
+
+/*
+ * Online simulation: processes are pulled from a workload reader in arrival
+ * order, admitted when they arrive and retired as soon as they finish, so
+ * memory scales with the number of processes in the system at once rather
+ * than with the length of the trace. The policies run on the same engine as
+ * in batch mode, so timelines match; a policy needs a grow hook (engine.h).
+ */
+typedef struct {
+    const policy_entry_t *policy;   // one that stream_supports
+    const policy_params_t *params;  // as filled in by policy->parse
+    FILE *results;              // one line per retired process (NULL = none)
+    timeline_sink_t *timeline;  // NULL = events are only counted
+    metrics_acc_t *metrics;     // fed as processes retire (NULL = none)
+    long snapshot_every;        // with metrics: snapshot line to results every N retirements (0 = off)
+} stream_config_t;
+
+typedef struct {
+    long retired;               // processes completed
+    sim_time_t total_time;      // sum of timeline durations
+    sim_time_t end_time;        // completion time of the last process
+    int peak_active;            // most processes held at once
+} stream_stats_t;
+
+/* 1 if run_stream can run policy. */
+int stream_supports(const policy_entry_t *policy);
+
+/* Returns 0 on success, -1 on bad input or an unsupported policy. */
+int run_stream(workload_reader_t *reader, const stream_config_t *config, stream_stats_t *stats);
+
+#endif // STREAM_H
@@ -0,0 +1,47 @@
+#ifndef SWEEP_H
+#define SWEEP_H
+
+#include "scheduler.h"
+#include "metrics.h"
+
+/*
+ * Parameter sweep over RR quanta and MLFQ configurations.
+ * MLFQ levels use doubling quantums: level i gets base_quantum << i,
+ * matching the {4,8,16} default of the report.
+ */
+typedef struct {
+    int lo;
+    int hi;
+    int step;
+} sweep_range_t;
+
+typedef struct {
+    sweep_range_t rr_quantum;
+    sweep_range_t mlfq_queues;
+    sweep_range_t mlfq_base_quantum;
+    sweep_range_t mlfq_boost;   // 0 = boost off
+    int threads;                // worker threads (<= 0: one per online CPU)
+} sweep_config_t;
+
+typedef struct {
+    const char *policy;         // "RR" or "MLFQ"
+    int quantum;                // RR quantum, or MLFQ base quantum
+    int num_queues;             // MLFQ only
+    int boost_interval;         // MLFQ only
+    metrics_t metrics;
+} sweep_point_t;
+
+/* Parse "v", "lo:hi" or "lo:hi:step"; "-" gives an empty range. Returns 0 on success. */
+int parse_range(const char *text, sweep_range_t *range);
+
+/*
+ * Run every grid point across a thread pool. processes is shared read-only;
+ * each worker simulates on its own process store. Points come back in grid order.
+ * Returns the number of points, or -1 on error.
+ */
+int run_sweep(const process_t *processes, int n, const sweep_config_t *config, sweep_point_t **out_points);
+
+/* Write points as CSV, or as a Markdown table when path ends in ".md". Returns 0 on success. */
+int write_sweep(const char *path, const sweep_point_t *points, int count);
+
+#endif // SWEEP_H
@@ -0,0 +1,85 @@
+#ifndef TIMELINE_H
+#define TIMELINE_H
+
+#include <stdio.h>
+#include "scheduler.h"
+
+/*
+ * Timeline sinks: every schedule_* function writes its events through one of these
+ * instead of into a caller-sized array. The base struct counts what it receives,
+ * so total simulated time is known even when events are not stored. A sink that
+ * cannot take an event sets error; it stays set and nothing more is counted, so
+ * callers check it once after the run.
+ */
+typedef struct timeline_sink {
+    void (*emit)(struct timeline_sink *self, const timeline_event_t *ev);
+    void (*flush)(struct timeline_sink *self);  // may be NULL
+    long events;                // events received
+    sim_time_t total_time;      // sum of received durations
+    int error;                  // an event was lost (sticky)
+} timeline_sink_t;
+
+static inline void timeline_emit_core(timeline_sink_t *sink, int core, sim_time_t time, int pid,
+                                      sim_time_t duration) {
+    timeline_event_t ev = { time, pid, duration, core };
+    sink->emit(sink, &ev);
+    if (sink->error) return;
+    sink->events++;
+    sink->total_time += duration;
+}
+
+/* Single-CPU schedulers: everything runs on core 0. */
+static inline void timeline_emit(timeline_sink_t *sink, sim_time_t time, int pid, sim_time_t duration) {
+    timeline_emit_core(sink, 0, time, pid, duration);
+}
+
+void timeline_flush(timeline_sink_t *sink);
+
+/* Growable in-memory buffer (doubling). */
+typedef struct {
+    timeline_sink_t base;
+    timeline_event_t *events;
+    size_t len;
+    size_t cap;
+} timeline_buffer_t;
+
+void timeline_buffer_init(timeline_buffer_t *buf);
+void timeline_buffer_reset(timeline_buffer_t *buf);
+void timeline_buffer_free(timeline_buffer_t *buf);
+
+/* Hands each event to fn(ev, ctx); with fn == NULL events are only counted. */
+typedef void (*timeline_callback_fn)(const timeline_event_t *ev, void *ctx);
+
+typedef struct {
+    timeline_sink_t base;
+    timeline_callback_fn fn;
+    void *ctx;
+} timeline_callback_t;
+
+void timeline_callback_init(timeline_callback_t *cb, timeline_callback_fn fn, void *ctx);
+
+/* Writes each event to a FILE as it is produced. */
+typedef struct {
+    timeline_sink_t base;
+    FILE *out;
+} timeline_stream_t;
+
+void timeline_stream_init(timeline_stream_t *stream, FILE *out);
+
+/*
+ * Run-length coalescing: merges back-to-back slices of the same pid before
+ * passing them on to downstream. Holds at most one pending event.
+ */
+typedef struct {
+    timeline_sink_t base;
+    timeline_sink_t *downstream;
+    timeline_event_t pending;
+    int has_pending;
+} timeline_coalesce_t;
+
+void timeline_coalesce_init(timeline_coalesce_t *co, timeline_sink_t *downstream);
+
+/* compute total_time from an event array */
+sim_time_t compute_total_time(timeline_event_t *timeline, size_t tlen);
+
+#endif // TIMELINE_H
@@ -0,0 +1,80 @@
+#ifndef WORKLOAD_H
+#define WORKLOAD_H
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "scheduler.h"
+
+/*
+ * Workload files: one "arrival burst priority" per line, pids assigned 1..n
+ * in file order. Blank lines and lines starting with '#' are skipped; any other
+ * line that is not three integers (arrival >= 0, burst > 0) is reported on
+ * stderr as "path:line: message" and the load fails.
+ * Binary workload files are recognised by their magic and loaded through mmap.
+ * Returns the number of processes loaded, or -1 on error.
+ */
+int load_workload(const char *path, process_t **out_processes);
+
+/* Write processes in the same text format. Returns 0 on success. */
+int write_workload(const char *path, const process_t *processes, int n);
+
+/*
+ * Incremental reader over the text format, for online simulation: yields one
+ * process at a time without loading the file. Input must be sorted by arrival.
+ * path "-" reads stdin.
+ */
+typedef struct {
+    FILE *f;
+    const char *path;
+    char *line;
+    size_t line_cap;
+    int lineno;
+    int last_arrival;
+    int next_pid;
+} workload_reader_t;
+
+int  workload_reader_open(workload_reader_t *reader, const char *path);  // 0 on success
+int  workload_reader_next(workload_reader_t *reader, process_t *out);    // 1 = process, 0 = end, -1 = error
+void workload_reader_close(workload_reader_t *reader);
+
+/*
+ * Binary workload format (host byte order, little-endian on x86):
+ *   header  { magic "SCHEDWL\0", version, record_size, count }
+ *   count packed records { arrival, burst, priority } (int32 each)
+ * pids are implicit: record i is pid i + 1.
+ * Records obey the text format's rules (arrival >= 0, burst > 0); loading
+ * fails on the first one that does not.
+ */
+#define WORKLOAD_BIN_MAGIC   "SCHEDWL"
+#define WORKLOAD_BIN_VERSION 1
+
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t record_size;       // sizeof(workload_record_t), guards against layout changes
+    uint64_t count;
+} workload_bin_header_t;
+
+typedef struct {
+    int32_t arrival;
+    int32_t burst;
+    int32_t priority;
+} workload_record_t;
+
+/* Read-only zero-copy view of a binary workload file. */
+typedef struct {
+    void *base;
+    size_t size;
+    const workload_record_t *records;
+    int count;
+} workload_map_t;
+
+int  workload_map_open(const char *path, workload_map_t *map);    // 0 on success
+void workload_map_close(workload_map_t *map);
+
+/* Expand a binary workload into a process array (as load_workload does). */
+int load_workload_bin(const char *path, process_t **out_processes);
+int write_workload_bin(const char *path, const process_t *processes, int n);
+
+#endif // WORKLOAD_H
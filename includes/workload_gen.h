@@ -0,0 +1,56 @@
+#ifndef WORKLOAD_GEN_H
+#define WORKLOAD_GEN_H
+
+#include <stdint.h>
+#include "scheduler.h"
+
+/*
+ * Seeded synthetic workload generator. The same config and seed always
+ * produce the same workload, on any platform (own PRNG, not rand()).
+ */
+typedef enum {
+    ARRIVAL_POISSON,            // exponential inter-arrival gaps
+    ARRIVAL_BURSTY              // Poisson batches of geometric size, batch members arrive together
+} arrival_dist_t;
+
+typedef enum {
+    BURST_EXPONENTIAL,          // mean burst_mean
+    BURST_BIMODAL,              // exponential short jobs (burst_mean) mixed with long jobs (burst_long_mean)
+    BURST_PARETO                // heavy tail with shape pareto_alpha and mean burst_mean
+} burst_dist_t;
+
+typedef struct {
+    int count;                  // processes to generate
+    uint64_t seed;
+    arrival_dist_t arrival;
+    double arrival_rate;        // mean processes per time unit
+    double batch_mean;          // ARRIVAL_BURSTY: mean processes per batch
+    burst_dist_t burst;
+    double burst_mean;
+    double burst_long_mean;     // BURST_BIMODAL
+    double long_fraction;       // BURST_BIMODAL: share of long jobs
+    double pareto_alpha;        // BURST_PARETO (> 1)
+    int max_burst;              // clamp for heavy tails (0 = no clamp)
+    int num_priorities;         // priorities 1..num_priorities
+    const double *priority_weights; // relative weight per priority, NULL = uniform
+} workload_gen_config_t;
+
+/* Defaults: Poisson arrivals at rate 0.5, exponential bursts of mean 10, 3 uniform priorities. */
+void workload_gen_defaults(workload_gen_config_t *config);
+
+/*
+ * Generate config->count processes sorted by arrival, pids 1..count, in the
+ * same shape load_workload returns. Returns the count, or -1 on error.
+ */
+int generate_workload(const workload_gen_config_t *config, process_t **out_processes);
+
+/* Small deterministic PRNG (splitmix64 seeding, xoshiro256** output). */
+typedef struct {
+    uint64_t s[4];
+} gen_rng_t;
+
+void gen_rng_seed(gen_rng_t *rng, uint64_t seed);
+uint64_t gen_rng_next(gen_rng_t *rng);
+double gen_rng_uniform(gen_rng_t *rng);    // in (0, 1)
+
+#endif // WORKLOAD_GEN_H
@@ -1,312 +1,842 @@
-/*
- * algorithms.c
- *
- * Implementations for FIFO, SJF, STCF, RR and MLFQ scheduling.
- *
- * Nota: all algorithms mutate the processes array (set remaining_time, start_time, completion_time, finished)
- * and append timeline events into the provided timeline array. timeline_len is set to number of events appended.
- *
- * This code favors clarity over extreme optimization.
- */
-
-#include <stdio.h>
-#include <stdlib.h>
-#include <string.h>
-#include <limits.h>
-#include "algorithms.h"
-
-/* helper: reset process bookkeeping */
-static void reset_processes(process_t *processes, int n) {
-    for (int i = 0; i < n; ++i) {
-        processes[i].remaining_time = processes[i].burst_time;
-        processes[i].start_time = -1;
-        processes[i].completion_time = -1;
-        processes[i].turnaround_time = 0;
-        processes[i].waiting_time = 0;
-        processes[i].response_time = -1;
-        processes[i].finished = 0;
-    }
-}
-
-/* helper: find first arrival time among processes (min arrival) */
-static int first_arrival(process_t *processes, int n) {
-    int mn = INT_MAX;
-    for (int i = 0; i < n; ++i) if (processes[i].arrival_time < mn) mn = processes[i].arrival_time;
-    return (mn == INT_MAX) ? 0 : mn;
-}
-
-/* Append timeline event */
-static void push_event(timeline_event_t *timeline, int *tlen, int time, int pid, int duration) {
-    timeline[*tlen].time = time;
-    timeline[*tlen].pid = pid;
-    timeline[*tlen].duration = duration;
-    (*tlen)++;
-}
-
-/* FIFO: non-preemptive, run by arrival order. Ties by pid. */
-void schedule_fifo(process_t *processes, int n, timeline_event_t *timeline, int *timeline_len) {
-    reset_processes(processes, n);
-    *timeline_len = 0;
-    // Create an index array sorted by arrival_time then pid
-    int *idx = malloc(sizeof(int)*n);
-    for (int i = 0; i < n; ++i) idx[i] = i;
-    // simple stable sort by arrival_time, then pid
-    for (int i = 0; i < n-1; ++i)
-        for (int j = i+1; j < n; ++j) {
-            if (processes[idx[i]].arrival_time > processes[idx[j]].arrival_time ||
-               (processes[idx[i]].arrival_time == processes[idx[j]].arrival_time &&
-                processes[idx[i]].pid > processes[idx[j]].pid)) {
-                int t = idx[i]; idx[i] = idx[j]; idx[j] = t;
-            }
-        }
-    int time = first_arrival(processes, n);
-    for (int k = 0; k < n; ++k) {
-        process_t *p = &processes[idx[k]];
-        if (time < p->arrival_time) {
-            // CPU idle until arrival
-            push_event(timeline, timeline_len, time, -1, p->arrival_time - time);
-            time = p->arrival_time;
-        }
-        // start
-        if (p->start_time == -1) p->start_time = time;
-        push_event(timeline, timeline_len, time, p->pid, p->burst_time);
-        time += p->burst_time;
-        p->remaining_time = 0;
-        p->completion_time = time;
-        p->finished = 1;
-    }
-    free(idx);
-}
-
-/* SJF: non-preemptive. At each scheduling point pick arrived process with smallest burst_time. */
-void schedule_sjf(process_t *processes, int n, timeline_event_t *timeline, int *timeline_len) {
-    reset_processes(processes, n);
-    *timeline_len = 0;
-    int completed = 0;
-    int time = first_arrival(processes, n);
-    while (completed < n) {
-        // find candidate among arrived & not finished with min burst_time (tie by arrival then pid)
-        int best = -1;
-        for (int i = 0; i < n; ++i) {
-            if (!processes[i].finished && processes[i].arrival_time <= time) {
-                if (best == -1 ||
-                    processes[i].burst_time < processes[best].burst_time ||
-                    (processes[i].burst_time == processes[best].burst_time && processes[i].arrival_time < processes[best].arrival_time)) {
-                    best = i;
-                }
-            }
-        }
-        if (best == -1) {
-            // idle until next arrival
-            int next_arr = INT_MAX;
-            for (int i = 0; i < n; ++i) if (!processes[i].finished && processes[i].arrival_time < next_arr) next_arr = processes[i].arrival_time;
-            push_event(timeline, timeline_len, time, -1, next_arr - time);
-            time = next_arr;
-            continue;
-        }
-        process_t *p = &processes[best];
-        if (p->start_time == -1) p->start_time = time;
-        push_event(timeline, timeline_len, time, p->pid, p->burst_time);
-        time += p->burst_time;
-        p->remaining_time = 0;
-        p->completion_time = time;
-        p->finished = 1;
-        completed++;
-    }
-}
-
-/* STCF: preemptive shortest remaining time first */
-void schedule_stcf(process_t *processes, int n, timeline_event_t *timeline, int *timeline_len) {
-    reset_processes(processes, n);
-    *timeline_len = 0;
-    int time = first_arrival(processes, n);
-    int completed = 0;
-    int current_pid = -1;
-    int current_idx = -1;
-    int current_start = -1;
-    while (completed < n) {
-        // pick process with smallest remaining_time among arrived and not finished
-        int best = -1;
-        for (int i = 0; i < n; ++i) {
-            if (!processes[i].finished && processes[i].arrival_time <= time) {
-                if (best == -1 || processes[i].remaining_time < processes[best].remaining_time ||
-                   (processes[i].remaining_time == processes[best].remaining_time && processes[i].arrival_time < processes[best].arrival_time)) {
-                    best = i;
-                }
-            }
-        }
-        if (best == -1) {
-            // idle until next arrival
-            int next_arr = INT_MAX;
-            for (int i = 0; i < n; ++i) if (!processes[i].finished && processes[i].arrival_time < next_arr) next_arr = processes[i].arrival_time;
-            push_event(timeline, timeline_len, time, -1, next_arr - time);
-            time = next_arr;
-            continue;
-        }
-        // run best for 1 time unit (granularity = 1)
-        process_t *p = &processes[best];
-        if (p->start_time == -1) p->start_time = time;
-        // If switching from another process, push the previous event
-        if (current_idx != best) {
-            // finish old event if exists
-            if (current_idx != -1) {
-                push_event(timeline, timeline_len, current_start, processes[current_idx].pid, time - current_start);
-            }
-            current_idx = best;
-            current_pid = p->pid;
-            current_start = time;
-        }
-        // execute 1 unit
-        p->remaining_time -= 1;
-        time += 1;
-        if (p->remaining_time == 0) {
-            // finish process
-            p->completion_time = time;
-            p->finished = 1;
-            completed++;
-            // finish current event
-            push_event(timeline, timeline_len, current_start, p->pid, time - current_start);
-            current_idx = -1;
-            current_start = -1;
-        }
-    }
-}
-
-/* Round Robin: preemptive with quantum; simple ready queue by arrival order. */
-void schedule_rr(process_t *processes, int n, int quantum, timeline_event_t *timeline, int *timeline_len) {
-    reset_processes(processes, n);
-    *timeline_len = 0;
-    int time = first_arrival(processes, n);
-    // simple queue of indices
-    int *queue = malloc(sizeof(int)*n*2);
-    int qhead = 0, qtail = 0;
-    int added[n];
-    memset(added, 0, sizeof(added));
-    // seed queue with processes that arrive at initial time
-    for (int i = 0; i < n; ++i) {
-        if (processes[i].arrival_time <= time) {
-            queue[qtail++] = i; added[i] = 1;
-        }
-    }
-    while (1) {
-        // if queue empty, advance to next arrival or break if all finished
-        int all_done = 1;
-        for (int i = 0; i < n; ++i) if (!processes[i].finished) { all_done = 0; break; }
-        if (all_done) break;
-        if (qhead == qtail) {
-            // idle until next arrival
-            int next_arr = INT_MAX;
-            for (int i = 0; i < n; ++i) if (!processes[i].finished && processes[i].arrival_time < next_arr) next_arr = processes[i].arrival_time;
-            push_event(timeline, timeline_len, time, -1, next_arr - time);
-            time = next_arr;
-            for (int i = 0; i < n; ++i) {
-                if (!added[i] && processes[i].arrival_time <= time) { queue[qtail++] = i; added[i] = 1; }
-            }
-            continue;
-        }
-        int idx = queue[qhead++];
-        process_t *p = &processes[idx];
-        if (p->start_time == -1) p->start_time = time;
-        int use = (p->remaining_time < quantum) ? p->remaining_time : quantum;
-        push_event(timeline, timeline_len, time, p->pid, use);
-        time += use;
-        p->remaining_time -= use;
-        // add newly arrived processes to queue
-        for (int i = 0; i < n; ++i) {
-            if (!added[i] && processes[i].arrival_time <= time) { queue[qtail++] = i; added[i] = 1; }
-        }
-        if (p->remaining_time > 0) {
-            // requeue at tail
-            queue[qtail++] = idx;
-        } else {
-            // finished
-            p->completion_time = time;
-            p->finished = 1;
-        }
-    }
-    free(queue);
-}
-
-/* MLFQ: multi-level feedback queue with num_queues (0 highest), quantums array, and optional boost interval.
-   Simplified behavior:
-   - All processes start in top queue (0).
-   - When a process uses full quantum at level i, it is demoted to i+1 (bounded at last).
-   - If it yields earlier (completes or is preempted because quantum ended?), since we run per-quantum slices, we demote only when it fully used the quantum.
-   - Boost: every boost_interval time units, all processes (not finished) move back to queue 0.
-   Implementation uses per-level FIFO queues.
-*/
-void schedule_mlfq(process_t *processes, int n, mlfq_config_t *config, timeline_event_t *timeline, int *timeline_len) {
-    reset_processes(processes, n);
-    *timeline_len = 0;
-    int numq = config->num_queues;
-    int **q = malloc(sizeof(int*)*numq);
-    int *qcap = malloc(sizeof(int)*numq);
-    int *qhead = malloc(sizeof(int)*numq);
-    int *qtail = malloc(sizeof(int)*numq);
-    for (int i = 0; i < numq; ++i) {
-        qcap[i] = n + 5;
-        q[i] = malloc(sizeof(int)*qcap[i]);
-        qhead[i] = qtail[i] = 0;
-    }
-    int time = first_arrival(processes, n);
-    int added[n];
-    memset(added, 0, sizeof(added));
-    int completed = 0;
-    int last_boost = time;
-    // add arrivals at start
-    for (int i = 0; i < n; ++i) if (processes[i].arrival_time <= time) { q[0][qtail[0]++] = i; added[i]=1; }
-    while (completed < n) {
-        if (config->boost_interval > 0 && time - last_boost >= config->boost_interval) {
-            // boost: move everyone to queue 0 preserving order by scanning queues
-            for (int level = 1; level < numq; ++level) {
-                while (qhead[level] < qtail[level]) {
-                    int pid = q[level][qhead[level]++];
-                    q[0][qtail[0]++] = pid;
-                }
-                qhead[level] = qtail[level] = 0;
-            }
-            last_boost = time;
-        }
-        // find highest non-empty queue
-        int level = -1;
-        for (int i = 0; i < numq; ++i) if (qhead[i] < qtail[i]) { level = i; break; }
-        if (level == -1) {
-            // no ready processes; advance to next arrival
-            int next_arr = INT_MAX;
-            for (int i = 0; i < n; ++i) if (!processes[i].finished && processes[i].arrival_time < next_arr) next_arr = processes[i].arrival_time;
-            if (next_arr==INT_MAX) break;
-            push_event(timeline, timeline_len, time, -1, next_arr - time);
-            time = next_arr;
-            for (int i = 0; i < n; ++i) if (!added[i] && processes[i].arrival_time <= time) { q[0][qtail[0]++] = i; added[i]=1; }
-            continue;
-        }
-        // pop from queue[level]
-        int idx = q[level][qhead[level]++];
-        process_t *p = &processes[idx];
-        if (p->start_time == -1) p->start_time = time;
-        int quantum = config->quantums[level];
-        int use = (p->remaining_time < quantum) ? p->remaining_time : quantum;
-        push_event(timeline, timeline_len, time, p->pid, use);
-        time += use;
-        p->remaining_time -= use;
-        // new arrivals appended to highest queue
-        for (int i = 0; i < n; ++i) if (!added[i] && processes[i].arrival_time <= time) { q[0][qtail[0]++] = i; added[i]=1; }
-        if (p->remaining_time == 0) {
-            p->completion_time = time;
-            p->finished = 1;
-            completed++;
-        } else {
-            // used full quantum? demote; else (if used < quantum) keep same level (but this should not happen because use < quantum only when finishing)
-            if (use >= quantum) {
-                int new_level = level + 1;
-                if (new_level >= numq) new_level = numq - 1;
-                q[new_level][qtail[new_level]++] = idx;
-            } else {
-                q[level][qtail[level]++] = idx;
-            }
-        }
-    }
-    for (int i = 0; i < numq; ++i) free(q[i]);
-    free(q); free(qcap); free(qhead); free(qtail);
-}
-
+/*
+ * algorithms.c
+ *
+ * Implementations for FIFO, SJF, STCF, RR, MLFQ, priority, lottery, stride and CFS scheduling.
+ *
+ * Nota: each algorithm is a set of sched_policy_t callbacks run by the shared engine (engine.c), which
+ * owns the clock, arrivals, idle gaps, timeline emission and completions. The policies only keep their
+ * ready queues: keys and remaining_time are read from the store's hot array. The schedule_* functions
+ * are thin wrappers that run one policy on a store; like the engine they reset it first, so the same
+ * store can be scheduled repeatedly. With SCHED_STATS defined the policies add their own counters
+ * (candidate scans, MLFQ demotions and boosts, priority aging passes) to the store's sched_stats_t.
+ *
+ * This code favors clarity over extreme optimization.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "algorithms.h"
+#include "engine.h"
+#include "policy.h"
+#include "ready_queue.h"
+#include "workload_gen.h"   // gen_rng_t for lottery draws
+
+/* Bounded FIFO ring of process indices; a process is never queued twice, so capacity n suffices. */
+typedef struct {
+    int *buf;
+    int cap;
+    int head;
+    int len;
+} index_ring_t;
+
+static int ring_init(index_ring_t *r, int cap) {
+    r->buf = malloc(sizeof(int) * (cap > 0 ? cap : 1));
+    r->cap = cap;
+    r->head = r->len = 0;
+    return r->buf ? 0 : -1;
+}
+
+static void ring_push(index_ring_t *r, int idx) {
+    int slot = r->head + r->len;
+    if (slot >= r->cap) slot -= r->cap;
+    r->buf[slot] = idx;
+    r->len++;
+}
+
+static int ring_pop(index_ring_t *r) {
+    int idx = r->buf[r->head];
+    if (++r->head == r->cap) r->head = 0;
+    r->len--;
+    return idx;
+}
+
+/* Move to a larger buffer of cap entries, queued indices first, head to tail. */
+static int ring_grow(index_ring_t *r, int cap) {
+    int *buf = malloc(sizeof(int) * cap);
+    if (!buf) return -1;
+    for (int k = 0, slot = r->head; k < r->len; ++k) {
+        buf[k] = r->buf[slot];
+        if (++slot == r->cap) slot = 0;
+    }
+    free(r->buf);
+    r->buf = buf;
+    r->cap = cap;
+    r->head = 0;
+    return 0;
+}
+
+/* checkpoint: an index list as its length and members, head first */
+static void ilist_save(const index_list_t *l, const int *link, ckpt_stream_t *out) {
+    int len = 0;
+    for (int idx = l->head; idx != -1; idx = link[idx]) len++;
+    ckpt_put(out, len);
+    for (int idx = l->head; idx != -1; idx = link[idx]) ckpt_put(out, idx);
+}
+
+/* FIFO and RR share a ring of arrived processes; FIFO runs each to completion, RR for a quantum. */
+typedef struct {
+    index_ring_t ring;
+    sim_time_t quantum;
+    sched_stats_t *st;
+} ring_state_t;
+
+static int ring_policy_init(void *state, process_store_t *ps, const policy_params_t *params, sim_time_t start) {
+    ring_state_t *s = state;
+    (void)start;
+    s->quantum = params->quantum > 0 ? params->quantum : SLICE_UNLIMITED;
+    s->st = ps->stats;
+    return ring_init(&s->ring, ps->n);
+}
+
+static void ring_policy_destroy(void *state) {
+    free(((ring_state_t *)state)->ring.buf);
+}
+
+static void ring_policy_enqueue(void *state, int idx, sim_time_t time) {
+    (void)time;
+    ring_push(&((ring_state_t *)state)->ring, idx);
+}
+
+static int ring_policy_pick(void *state, sim_time_t time) {
+    ring_state_t *s = state;
+    (void)time;
+    if (s->ring.len == 0) return -1;
+    SCHED_COUNT(s->st, candidate_scans, 1);
+    return ring_pop(&s->ring);
+}
+
+static sim_time_t ring_policy_slice(void *state, int idx, sim_time_t time) {
+    (void)idx; (void)time;
+    return ((ring_state_t *)state)->quantum;
+}
+
+static void ring_policy_requeue(void *state, int idx, sim_time_t ran, sim_time_t time) {
+    (void)ran; (void)time;
+    ring_push(&((ring_state_t *)state)->ring, idx);   // back to the tail
+}
+
+/* checkpoint: the ring from head to tail */
+static void ring_policy_save(const void *state, ckpt_stream_t *out) {
+    const index_ring_t *r = &((const ring_state_t *)state)->ring;
+    ckpt_put(out, r->len);
+    for (int k = 0, slot = r->head; k < r->len; ++k) {
+        ckpt_put(out, r->buf[slot]);
+        if (++slot == r->cap) slot = 0;
+    }
+}
+
+static void ring_policy_load(void *state, int n, ckpt_stream_t *in) {
+    ring_state_t *s = state;
+    int len = (int)ckpt_get_range(in, 0, n);
+    for (int k = 0; k < len; ++k) {
+        int idx = (int)ckpt_get_range(in, 0, n - 1);
+        if (in->err) return;
+        ring_push(&s->ring, idx);
+    }
+}
+
+static int ring_policy_grow(void *state, process_store_t *ps) {
+    return ring_grow(&((ring_state_t *)state)->ring, ps->n);
+}
+
+/* FIFO: non-preemptive, run by arrival order. Ties keep input order (pid order for loaded workloads). */
+const sched_policy_t policy_fifo = {
+    "fifo", sizeof(ring_state_t), ring_policy_init, ring_policy_destroy, ring_policy_enqueue,
+    ring_policy_pick, ring_policy_slice, NULL, NULL, ring_policy_requeue, NULL,
+    ring_policy_save, ring_policy_load, ring_policy_grow
+};
+
+/* Round Robin: preemptive with quantum; simple ready queue by arrival order.
+   Processes that arrive during a slice are queued ahead of the preempted one. */
+const sched_policy_t policy_rr = {
+    "rr", sizeof(ring_state_t), ring_policy_init, ring_policy_destroy, ring_policy_enqueue,
+    ring_policy_pick, ring_policy_slice, NULL, NULL, ring_policy_requeue, NULL,
+    ring_policy_save, ring_policy_load, ring_policy_grow
+};
+
+/* SJF and STCF: arrived processes sit in a min-heap keyed by (burst, arrival, pid) or
+   (remaining, arrival, pid), so a whole run costs O(n log n). */
+typedef struct {
+    ready_queue_t rq;
+    process_hot_t *hot;
+    sched_stats_t *st;
+} shortest_state_t;
+
+static int shortest_init(shortest_state_t *s, process_store_t *ps, rq_cmp_fn cmp) {
+    s->hot = ps->hot;
+    s->st = ps->stats;
+    return rq_init(&s->rq, ps->hot, ps->n, cmp);
+}
+
+static int sjf_init(void *state, process_store_t *ps, const policy_params_t *params, sim_time_t start) {
+    (void)params; (void)start;
+    return shortest_init(state, ps, rq_cmp_burst);
+}
+
+static int stcf_init(void *state, process_store_t *ps, const policy_params_t *params, sim_time_t start) {
+    (void)params; (void)start;
+    return shortest_init(state, ps, rq_cmp_remaining);
+}
+
+static void shortest_destroy(void *state) {
+    shortest_state_t *s = state;
+    SCHED_COUNT(s->st, candidate_scans, s->rq.comparisons);
+    rq_free(&s->rq);
+}
+
+static void shortest_enqueue(void *state, int idx, sim_time_t time) {
+    (void)time;
+    rq_push(&((shortest_state_t *)state)->rq, idx);
+}
+
+static int shortest_pick(void *state, sim_time_t time) {
+    (void)time;
+    return rq_pop(&((shortest_state_t *)state)->rq);
+}
+
+static sim_time_t unlimited_slice(void *state, int idx, sim_time_t time) {
+    (void)state; (void)idx; (void)time;
+    return SLICE_UNLIMITED;
+}
+
+/* STCF preempts when a ready process now has less remaining time than the running one. */
+static int stcf_preempt(void *state, int idx, sim_time_t time) {
+    shortest_state_t *s = state;
+    (void)time;
+    if (rq_empty(&s->rq)) return 0;
+    SCHED_COUNT(s->st, candidate_scans, 1);
+    return rq_cmp_remaining(&s->hot[rq_peek(&s->rq)], &s->hot[idx]) < 0;
+}
+
+static void shortest_requeue(void *state, int idx, sim_time_t ran, sim_time_t time) {
+    (void)ran; (void)time;
+    rq_push(&((shortest_state_t *)state)->rq, idx);
+}
+
+/* checkpoint: the heap array; pushing it back in slot order rebuilds it without a single swap */
+static void heap_save(const ready_queue_t *rq, ckpt_stream_t *out) {
+    ckpt_put(out, rq->size);
+    for (int k = 0; k < rq->size; ++k) ckpt_put(out, rq->heap[k]);
+}
+
+static void heap_load(ready_queue_t *rq, int n, ckpt_stream_t *in) {
+    int size = (int)ckpt_get_range(in, 0, n);
+    for (int k = 0; k < size; ++k) {
+        int idx = (int)ckpt_get_range(in, 0, n - 1);
+        if (in->err) return;
+        rq_push(rq, idx);
+    }
+}
+
+static void shortest_save(const void *state, ckpt_stream_t *out) {
+    heap_save(&((const shortest_state_t *)state)->rq, out);
+}
+
+static void shortest_load(void *state, int n, ckpt_stream_t *in) {
+    heap_load(&((shortest_state_t *)state)->rq, n, in);
+}
+
+static int shortest_grow(void *state, process_store_t *ps) {
+    shortest_state_t *s = state;
+    s->hot = ps->hot;
+    return rq_reserve(&s->rq, ps->hot, ps->n);
+}
+
+/* SJF: non-preemptive. At each scheduling point pick arrived process with smallest burst_time. */
+const sched_policy_t policy_sjf = {
+    "sjf", sizeof(shortest_state_t), sjf_init, shortest_destroy, shortest_enqueue,
+    shortest_pick, unlimited_slice, NULL, NULL, shortest_requeue, NULL,
+    shortest_save, shortest_load, shortest_grow
+};
+
+/* STCF: preemptive shortest remaining time first. The running process only loses the CPU when it
+   completes or when an arrival beats it, so the engine jumps straight to whichever comes first. */
+const sched_policy_t policy_stcf = {
+    "stcf", sizeof(shortest_state_t), stcf_init, shortest_destroy, shortest_enqueue,
+    shortest_pick, unlimited_slice, stcf_preempt, NULL, shortest_requeue, NULL,
+    shortest_save, shortest_load, shortest_grow
+};
+
+/* MLFQ: multi-level feedback queue with num_queues (0 highest), quantums array, and optional boost interval.
+   Simplified behavior:
+   - All processes start in top queue (0).
+   - When a process uses full quantum at level i, it is demoted to i+1 (bounded at last).
+   - If it yields earlier (completes or is preempted because quantum ended?), since we run per-quantum slices, we demote only when it fully used the quantum.
+   - Boost: every boost_interval time units, all processes (not finished) move back to queue 0.
+   Implementation uses per-level intrusive FIFO lists (index_list_t); a boost splices each lower level onto
+   queue 0 in order, so it costs O(num_queues) regardless of how many processes are waiting.
+*/
+typedef struct {
+    const mlfq_config_t *config;
+    index_list_t *q;
+    int *link;
+    sim_time_t last_boost;
+    int level;                  // level the running process was picked from
+    sched_stats_t *st;
+} mlfq_state_t;
+
+static int mlfq_init(void *state, process_store_t *ps, const policy_params_t *params, sim_time_t start) {
+    mlfq_state_t *s = state;
+    s->config = &params->mlfq;
+    s->q = malloc(sizeof(index_list_t) * s->config->num_queues);
+    s->link = malloc(sizeof(int) * (ps->n > 0 ? ps->n : 1));
+    if (!s->q || !s->link) { free(s->q); free(s->link); return -1; }
+    for (int i = 0; i < s->config->num_queues; ++i) ilist_init(&s->q[i]);
+    s->last_boost = start;
+    s->st = ps->stats;
+    return 0;
+}
+
+static void mlfq_destroy(void *state) {
+    mlfq_state_t *s = state;
+    free(s->q);
+    free(s->link);
+}
+
+static void mlfq_enqueue(void *state, int idx, sim_time_t time) {
+    mlfq_state_t *s = state;
+    (void)time;
+    ilist_push(&s->q[0], s->link, idx);     // new arrivals go to the highest queue
+}
+
+static int mlfq_pick(void *state, sim_time_t time) {
+    mlfq_state_t *s = state;
+    int numq = s->config->num_queues;
+    if (s->config->boost_interval > 0 && time - s->last_boost >= s->config->boost_interval) {
+        // boost: move everyone to queue 0 preserving order
+        for (int level = 1; level < numq; ++level) ilist_splice(&s->q[0], &s->q[level], s->link);
+        s->last_boost = time;
+        SCHED_COUNT(s->st, boosts, 1);
+    }
+    // find highest non-empty queue
+    int level = -1;
+    for (int i = 0; i < numq; ++i) if (!ilist_empty(&s->q[i])) { level = i; break; }
+    SCHED_COUNT(s->st, candidate_scans, level == -1 ? numq : level + 1);
+    if (level == -1) return -1;
+    s->level = level;
+    return ilist_pop(&s->q[level], s->link);
+}
+
+static sim_time_t mlfq_slice(void *state, int idx, sim_time_t time) {
+    mlfq_state_t *s = state;
+    (void)idx; (void)time;
+    return s->config->quantums[s->level];
+}
+
+static void mlfq_requeue(void *state, int idx, sim_time_t ran, sim_time_t time) {
+    mlfq_state_t *s = state;
+    (void)time;
+    int level = s->level;
+    // used full quantum? demote; else keep same level (only reachable when finishing, so never in practice)
+    if (ran >= s->config->quantums[level]) {
+        int new_level = level + 1;
+        if (new_level >= s->config->num_queues) new_level = s->config->num_queues - 1;
+        if (new_level != level) SCHED_COUNT(s->st, demotions, 1);
+        level = new_level;
+    }
+    ilist_push(&s->q[level], s->link, idx);
+}
+
+/* checkpoint: boost clock, running level and every level's queue; the level count must match on load */
+static void mlfq_save(const void *state, ckpt_stream_t *out) {
+    const mlfq_state_t *s = state;
+    ckpt_put(out, s->last_boost);
+    ckpt_put(out, s->level);
+    ckpt_put(out, s->config->num_queues);
+    for (int level = 0; level < s->config->num_queues; ++level) ilist_save(&s->q[level], s->link, out);
+}
+
+static void mlfq_load(void *state, int n, ckpt_stream_t *in) {
+    mlfq_state_t *s = state;
+    int numq = s->config->num_queues;
+    s->last_boost = ckpt_get(in);
+    s->level = (int)ckpt_get_range(in, 0, numq - 1);
+    ckpt_get_range(in, numq, numq);
+    for (int level = 0; level < numq && !in->err; ++level) {
+        int len = (int)ckpt_get_range(in, 0, n);
+        for (int k = 0; k < len; ++k) {
+            int idx = (int)ckpt_get_range(in, 0, n - 1);
+            if (in->err) return;
+            ilist_push(&s->q[level], s->link, idx);
+        }
+    }
+}
+
+static int mlfq_grow(void *state, process_store_t *ps) {
+    mlfq_state_t *s = state;
+    int *link = realloc(s->link, sizeof(int) * ps->n);
+    if (!link) return -1;
+    s->link = link;
+    return 0;
+}
+
+const sched_policy_t policy_mlfq = {
+    "mlfq", sizeof(mlfq_state_t), mlfq_init, mlfq_destroy, mlfq_enqueue,
+    mlfq_pick, mlfq_slice, NULL, NULL, mlfq_requeue, NULL, mlfq_save, mlfq_load, mlfq_grow
+};
+
+/* Priority scheduling: lowest priority value first, FIFO within a level, on an O(1) bucket queue.
+   Aging is applied lazily: before each arrival is queued and at every scheduling point, the ticks
+   elapsed since the last one move all waiting processes up that many levels in one O(64) pass.
+   The running process keeps the level it was picked from; if preempted it goes back to the tail
+   of its own (unaged) level. In preemptive mode the running process is also stopped at the tick
+   where aging first lifts a waiting one above it. */
+typedef struct {
+    prio_queue_t pq;
+    process_hot_t *hot;
+    int interval;
+    sim_time_t aged_until;      // last aging tick applied
+    int current_bucket;         // level the running process was picked from
+    sched_stats_t *st;
+} prio_state_t;
+
+static void age_to(prio_state_t *s, sim_time_t time) {
+    if (s->interval <= 0 || time - s->aged_until < s->interval) return;
+    sim_time_t ticks = (time - s->aged_until) / s->interval;
+    s->aged_until += ticks * s->interval;
+    if (pq_empty(&s->pq)) return;
+    pq_age(&s->pq, ticks >= PRIO_BUCKETS ? PRIO_BUCKETS - 1 : (int)ticks);
+    SCHED_COUNT(s->st, boosts, 1);
+}
+
+static int prio_init(void *state, process_store_t *ps, const policy_params_t *params, sim_time_t start) {
+    prio_state_t *s = state;
+    s->hot = ps->hot;
+    s->interval = params->prio.aging_interval;
+    s->aged_until = start;
+    s->st = ps->stats;
+    return pq_init(&s->pq, ps->n);
+}
+
+static void prio_destroy(void *state) {
+    pq_free(&((prio_state_t *)state)->pq);
+}
+
+static void prio_enqueue(void *state, int idx, sim_time_t time) {
+    prio_state_t *s = state;
+    age_to(s, time);
+    pq_push(&s->pq, idx, prio_bucket(s->hot[idx].priority));
+}
+
+static int prio_pick(void *state, sim_time_t time) {
+    prio_state_t *s = state;
+    age_to(s, time);
+    if (pq_empty(&s->pq)) return -1;
+    s->current_bucket = pq_best(&s->pq);
+    return pq_pop(&s->pq);
+}
+
+/* preemptive: run until the tick where aging lifts a waiting process above the running one */
+static sim_time_t pprio_slice(void *state, int idx, sim_time_t time) {
+    prio_state_t *s = state;
+    (void)idx;
+    if (s->interval <= 0 || pq_empty(&s->pq) || s->current_bucket == 0) return SLICE_UNLIMITED;
+    int lift = pq_best(&s->pq) - s->current_bucket + 1;
+    return s->aged_until + (sim_time_t)lift * s->interval - time;
+}
+
+static int pprio_preempt(void *state, int idx, sim_time_t time) {
+    prio_state_t *s = state;
+    (void)idx;
+    age_to(s, time);
+    if (pq_empty(&s->pq)) return 0;
+    SCHED_COUNT(s->st, candidate_scans, 1);
+    return pq_best(&s->pq) < s->current_bucket;
+}
+
+static void prio_requeue(void *state, int idx, sim_time_t ran, sim_time_t time) {
+    prio_state_t *s = state;
+    (void)ran;
+    age_to(s, time);
+    pq_push(&s->pq, idx, prio_bucket(s->hot[idx].priority));
+}
+
+/* checkpoint: aging clock, running bucket and all PRIO_BUCKETS queues (empty ones cost a byte) */
+static void prio_save(const void *state, ckpt_stream_t *out) {
+    const prio_state_t *s = state;
+    ckpt_put(out, s->aged_until);
+    ckpt_put(out, s->current_bucket);
+    for (int b = 0; b < PRIO_BUCKETS; ++b) ilist_save(&s->pq.bucket[b], s->pq.link, out);
+}
+
+static void prio_load(void *state, int n, ckpt_stream_t *in) {
+    prio_state_t *s = state;
+    s->aged_until = ckpt_get(in);
+    s->current_bucket = (int)ckpt_get_range(in, 0, PRIO_BUCKETS - 1);
+    for (int b = 0; b < PRIO_BUCKETS && !in->err; ++b) {
+        int len = (int)ckpt_get_range(in, 0, n);
+        for (int k = 0; k < len; ++k) {
+            int idx = (int)ckpt_get_range(in, 0, n - 1);
+            if (in->err) return;
+            pq_push(&s->pq, idx, b);
+        }
+    }
+}
+
+const sched_policy_t policy_priority = {
+    "priority", sizeof(prio_state_t), prio_init, prio_destroy, prio_enqueue,
+    prio_pick, unlimited_slice, NULL, NULL, prio_requeue, NULL, prio_save, prio_load, NULL
+};
+
+const sched_policy_t policy_ppriority = {
+    "ppriority", sizeof(prio_state_t), prio_init, prio_destroy, prio_enqueue,
+    prio_pick, pprio_slice, pprio_preempt, NULL, prio_requeue, NULL, prio_save, prio_load, NULL
+};
+
+/* Lottery: every quantum, draw a winning ticket among the arrived processes (tickets from
+   priority_tickets). Tickets live in a Fenwick tree indexed by process, so a draw and a
+   process joining or leaving are O(log n); unfinished processes keep their tickets, so a
+   slice costs no queue traffic. Draws come from a seeded generator and are reproducible. */
+typedef struct {
+    ticket_tree_t tickets;
+    gen_rng_t rng;
+    process_hot_t *hot;
+    sim_time_t quantum;
+    sched_stats_t *st;
+} lottery_state_t;
+
+static int lottery_init(void *state, process_store_t *ps, const policy_params_t *params, sim_time_t start) {
+    lottery_state_t *s = state;
+    (void)start;
+    s->hot = ps->hot;
+    s->quantum = params->quantum;
+    s->st = ps->stats;
+    gen_rng_seed(&s->rng, params->seed);
+    return tt_init(&s->tickets, ps->n);
+}
+
+static void lottery_destroy(void *state) {
+    tt_free(&((lottery_state_t *)state)->tickets);
+}
+
+static void lottery_enqueue(void *state, int idx, sim_time_t time) {
+    lottery_state_t *s = state;
+    (void)time;
+    tt_add(&s->tickets, idx, priority_tickets(s->hot[idx].priority));
+}
+
+static int lottery_pick(void *state, sim_time_t time) {
+    lottery_state_t *s = state;
+    (void)time;
+    if (s->tickets.total == 0) return -1;
+    // unbiased enough for any ticket total: high 64 bits of a 64x64 product
+    long long winner = (long long)(((unsigned __int128)gen_rng_next(&s->rng) * (uint64_t)s->tickets.total) >> 64);
+    SCHED_COUNT(s->st, candidate_scans, 1);
+    return tt_find(&s->tickets, winner);
+}
+
+static sim_time_t lottery_slice(void *state, int idx, sim_time_t time) {
+    (void)idx; (void)time;
+    return ((lottery_state_t *)state)->quantum;
+}
+
+static void lottery_requeue(void *state, int idx, sim_time_t ran, sim_time_t time) {
+    (void)state; (void)idx; (void)ran; (void)time;   // tickets stay in the tree
+}
+
+static void lottery_complete(void *state, int idx, sim_time_t time) {
+    lottery_state_t *s = state;
+    (void)time;
+    tt_add(&s->tickets, idx, -priority_tickets(s->hot[idx].priority));
+}
+
+/* checkpoint: generator state and the ticket holders; their tickets follow from their priorities */
+static void lottery_save(const void *state, ckpt_stream_t *out) {
+    const lottery_state_t *s = state;
+    for (int k = 0; k < 4; ++k) ckpt_put(out, (long long)s->rng.s[k]);
+    int holders = 0;
+    for (int idx = 0; idx < s->tickets.n; ++idx) if (tt_get(&s->tickets, idx) > 0) holders++;
+    ckpt_put(out, holders);
+    for (int idx = 0; idx < s->tickets.n; ++idx) if (tt_get(&s->tickets, idx) > 0) ckpt_put(out, idx);
+}
+
+static void lottery_load(void *state, int n, ckpt_stream_t *in) {
+    lottery_state_t *s = state;
+    for (int k = 0; k < 4; ++k) s->rng.s[k] = (uint64_t)ckpt_get(in);
+    int holders = (int)ckpt_get_range(in, 0, n);
+    for (int k = 0; k < holders; ++k) {
+        int idx = (int)ckpt_get_range(in, 0, n - 1);
+        if (in->err) return;
+        tt_add(&s->tickets, idx, priority_tickets(s->hot[idx].priority));
+    }
+}
+
+const sched_policy_t policy_lottery = {
+    "lottery", sizeof(lottery_state_t), lottery_init, lottery_destroy, lottery_enqueue,
+    lottery_pick, lottery_slice, NULL, NULL, lottery_requeue, lottery_complete,
+    lottery_save, lottery_load, NULL
+};
+
+/* Stride: the arrived process with the smallest pass runs for a quantum, then its pass grows by
+   its stride (STRIDE1 / tickets), so CPU time is shared in proportion to tickets without
+   randomness. Newcomers join at the pass of the last dispatched process rather than 0, so they
+   cannot monopolize the CPU. Passes sit in a min-heap: O(log n) per slice. */
+#define STRIDE1 ((long long)TICKETS_MAX << 10)
+
+typedef struct {
+    ready_queue_t rq;
+    long long *pass;
+    long long global_pass;      // pass of the last dispatched process
+    process_hot_t *hot;
+    sim_time_t quantum;
+    sched_stats_t *st;
+} stride_state_t;
+
+static int stride_init(void *state, process_store_t *ps, const policy_params_t *params, sim_time_t start) {
+    stride_state_t *s = state;
+    (void)start;
+    s->hot = ps->hot;
+    s->quantum = params->quantum;
+    s->st = ps->stats;
+    s->pass = calloc(ps->n > 0 ? ps->n : 1, sizeof(long long));
+    if (!s->pass || rq_init_keyed(&s->rq, ps->hot, ps->n, s->pass) != 0) { free(s->pass); return -1; }
+    return 0;
+}
+
+static void stride_destroy(void *state) {
+    stride_state_t *s = state;
+    SCHED_COUNT(s->st, candidate_scans, s->rq.comparisons);
+    rq_free(&s->rq);
+    free(s->pass);
+}
+
+static void stride_enqueue(void *state, int idx, sim_time_t time) {
+    stride_state_t *s = state;
+    (void)time;
+    s->pass[idx] = s->global_pass;
+    rq_push(&s->rq, idx);
+}
+
+static int stride_pick(void *state, sim_time_t time) {
+    stride_state_t *s = state;
+    (void)time;
+    int idx = rq_pop(&s->rq);
+    if (idx >= 0) s->global_pass = s->pass[idx];
+    return idx;
+}
+
+static sim_time_t stride_slice(void *state, int idx, sim_time_t time) {
+    (void)idx; (void)time;
+    return ((stride_state_t *)state)->quantum;
+}
+
+/* arrivals during the slice already joined at the current pass, ahead of idx on ties */
+static void stride_requeue(void *state, int idx, sim_time_t ran, sim_time_t time) {
+    stride_state_t *s = state;
+    (void)ran; (void)time;
+    s->pass[idx] += STRIDE1 / priority_tickets(s->hot[idx].priority);
+    rq_push(&s->rq, idx);
+}
+
+/* checkpoint: global pass, every pass (the running process's is not in the heap) and the heap */
+static void stride_save(const void *state, ckpt_stream_t *out) {
+    const stride_state_t *s = state;
+    ckpt_put(out, s->global_pass);
+    for (int idx = 0; idx < s->rq.capacity; ++idx) ckpt_put(out, s->pass[idx]);
+    heap_save(&s->rq, out);
+}
+
+static void stride_load(void *state, int n, ckpt_stream_t *in) {
+    stride_state_t *s = state;
+    s->global_pass = ckpt_get(in);
+    for (int idx = 0; idx < n; ++idx) s->pass[idx] = ckpt_get(in);
+    heap_load(&s->rq, n, in);
+}
+
+const sched_policy_t policy_stride = {
+    "stride", sizeof(stride_state_t), stride_init, stride_destroy, stride_enqueue,
+    stride_pick, stride_slice, NULL, NULL, stride_requeue, NULL, stride_save, stride_load, NULL
+};
+
+/* Load weight per nice level, -20..19 (the Linux sched_prio_to_weight table): each level is ~10% CPU. */
+static const int nice_to_weight[40] = {
+    88761, 71755, 56483, 46273, 36291,
+    29154, 23254, 18705, 14949, 11916,
+     9548,  7620,  6100,  4904,  3906,
+     3121,  2501,  1991,  1586,  1277,
+     1024,   820,   655,   526,   423,
+      335,   272,   215,   172,   137,
+      110,    87,    70,    56,    45,
+       36,    29,    23,    18,    15,
+};
+
+#define CFS_NICE0_WEIGHT 1024
+
+int cfs_weight(int priority) {
+    int nice = priority - 1;
+    if (nice < -20) nice = -20;
+    if (nice > 19) nice = 19;
+    return nice_to_weight[nice + 20];
+}
+
+/* CFS: runnable processes sit in a red-black tree keyed by vruntime (time run, scaled by
+   1024 / weight, in 1/1024 time units) and the leftmost one runs next. Its slice is its weight's
+   share of the scheduling period (target_latency, or n * min_granularity when more processes
+   are runnable), never below min_granularity. Newcomers start at min_vruntime so they neither
+   starve nor monopolize the CPU; slices are not cut short by arrivals. Insert, remove and
+   pick-next are O(log n). */
+typedef struct {
+    rb_tree_t tree;
+    long long *vruntime;
+    long long min_vruntime;
+    long long load;             // total weight of the runnable processes, the running one included
+    long long latency;
+    long long granularity;
+    int runnable;               // runnable processes when the running one was picked
+    process_hot_t *hot;
+    sched_stats_t *st;
+} cfs_state_t;
+
+static int cfs_init(void *state, process_store_t *ps, const policy_params_t *params, sim_time_t start) {
+    cfs_state_t *s = state;
+    (void)start;
+    s->hot = ps->hot;
+    s->st = ps->stats;
+    s->latency = params->cfs.target_latency > 0 ? params->cfs.target_latency : 1;
+    s->granularity = params->cfs.min_granularity > 0 ? params->cfs.min_granularity : 1;
+    s->vruntime = calloc(ps->n > 0 ? ps->n : 1, sizeof(long long));
+    if (!s->vruntime || rbt_init(&s->tree, ps->n, s->vruntime) != 0) { free(s->vruntime); return -1; }
+    return 0;
+}
+
+static void cfs_destroy(void *state) {
+    cfs_state_t *s = state;
+    SCHED_COUNT(s->st, candidate_scans, s->tree.comparisons);
+    rbt_free(&s->tree);
+    free(s->vruntime);
+}
+
+static void cfs_enqueue(void *state, int idx, sim_time_t time) {
+    cfs_state_t *s = state;
+    (void)time;
+    s->vruntime[idx] = s->min_vruntime;
+    rbt_insert(&s->tree, idx);
+    s->load += cfs_weight(s->hot[idx].priority);
+}
+
+static int cfs_pick(void *state, sim_time_t time) {
+    cfs_state_t *s = state;
+    (void)time;
+    int idx = rbt_first(&s->tree);
+    if (idx < 0) return -1;
+    s->runnable = s->tree.size;
+    rbt_remove(&s->tree, idx);
+    return idx;
+}
+
+static sim_time_t cfs_slice(void *state, int idx, sim_time_t time) {
+    cfs_state_t *s = state;
+    (void)time;
+    long long period = (s->runnable * s->granularity > s->latency) ? s->runnable * s->granularity : s->latency;
+    long long slice = period * cfs_weight(s->hot[idx].priority) / s->load;
+    return slice < s->granularity ? s->granularity : slice;
+}
+
+/* charge the slice, then let min_vruntime follow the smaller of the running and leftmost vruntimes */
+static void cfs_tick(void *state, int idx, sim_time_t ran, sim_time_t time) {
+    cfs_state_t *s = state;
+    (void)time;
+    s->vruntime[idx] += ran * CFS_NICE0_WEIGHT * 1024 / cfs_weight(s->hot[idx].priority);
+    long long floor_v = s->vruntime[idx];
+    if (!rbt_empty(&s->tree) && s->vruntime[rbt_first(&s->tree)] < floor_v) floor_v = s->vruntime[rbt_first(&s->tree)];
+    if (floor_v > s->min_vruntime) s->min_vruntime = floor_v;
+}
+
+static void cfs_requeue(void *state, int idx, sim_time_t ran, sim_time_t time) {
+    (void)ran; (void)time;
+    rbt_insert(&((cfs_state_t *)state)->tree, idx);
+}
+
+static void cfs_complete(void *state, int idx, sim_time_t time) {
+    cfs_state_t *s = state;
+    (void)time;
+    s->load -= cfs_weight(s->hot[idx].priority);
+}
+
+/* checkpoint: clocks and load, every vruntime, then the tree in order; reinserting rebuilds the same order */
+static void cfs_save(const void *state, ckpt_stream_t *out) {
+    const cfs_state_t *s = state;
+    ckpt_put(out, s->min_vruntime);
+    ckpt_put(out, s->load);
+    ckpt_put(out, s->runnable);
+    for (int idx = 0; idx < s->tree.nil; ++idx) ckpt_put(out, s->vruntime[idx]);
+    int *items = malloc(sizeof(int) * (s->tree.size > 0 ? s->tree.size : 1));
+    if (!items) { out->err = 1; return; }
+    int count = rbt_items(&s->tree, items);
+    ckpt_put(out, count);
+    for (int k = 0; k < count; ++k) ckpt_put(out, items[k]);
+    free(items);
+}
+
+static void cfs_load(void *state, int n, ckpt_stream_t *in) {
+    cfs_state_t *s = state;
+    s->min_vruntime = ckpt_get(in);
+    s->load = ckpt_get(in);
+    s->runnable = (int)ckpt_get_range(in, 0, n);
+    for (int idx = 0; idx < n; ++idx) s->vruntime[idx] = ckpt_get(in);
+    int count = (int)ckpt_get_range(in, 0, n);
+    for (int k = 0; k < count; ++k) {
+        int idx = (int)ckpt_get_range(in, 0, n - 1);
+        if (in->err) return;
+        rbt_insert(&s->tree, idx);
+    }
+}
+
+const sched_policy_t policy_cfs = {
+    "cfs", sizeof(cfs_state_t), cfs_init, cfs_destroy, cfs_enqueue,
+    cfs_pick, cfs_slice, NULL, cfs_tick, cfs_requeue, cfs_complete, cfs_save, cfs_load, NULL
+};
+
+/* Direct entry points, one per policy: build its parameters and run it through the engine. */
+void schedule_fifo(process_store_t *ps, timeline_sink_t *timeline) {
+    policy_params_t params = {0};
+    engine_run(ps, &policy_fifo, &params, timeline);
+}
+
+void schedule_sjf(process_store_t *ps, timeline_sink_t *timeline) {
+    policy_params_t params = {0};
+    engine_run(ps, &policy_sjf, &params, timeline);
+}
+
+void schedule_stcf(process_store_t *ps, timeline_sink_t *timeline) {
+    policy_params_t params = {0};
+    engine_run(ps, &policy_stcf, &params, timeline);
+}
+
+void schedule_rr(process_store_t *ps, int quantum, timeline_sink_t *timeline) {
+    policy_params_t params = {0};
+    params.quantum = quantum;
+    engine_run(ps, &policy_rr, &params, timeline);
+}
+
+void schedule_mlfq(process_store_t *ps, mlfq_config_t *config, timeline_sink_t *timeline) {
+    policy_params_t params = {0};
+    params.mlfq = *config;
+    engine_run(ps, &policy_mlfq, &params, timeline);
+}
+
+void schedule_priority(process_store_t *ps, const priority_config_t *config, timeline_sink_t *timeline) {
+    policy_params_t params = {0};
+    params.prio = *config;
+    engine_run(ps, config->preemptive ? &policy_ppriority : &policy_priority, &params, timeline);
+}
+
+void schedule_lottery(process_store_t *ps, int quantum, uint64_t seed, timeline_sink_t *timeline) {
+    policy_params_t params = {0};
+    params.quantum = quantum;
+    params.seed = seed;
+    engine_run(ps, &policy_lottery, &params, timeline);
+}
+
+void schedule_stride(process_store_t *ps, int quantum, timeline_sink_t *timeline) {
+    policy_params_t params = {0};
+    params.quantum = quantum;
+    engine_run(ps, &policy_stride, &params, timeline);
+}
+
+void schedule_cfs(process_store_t *ps, const cfs_config_t *config, timeline_sink_t *timeline) {
+    policy_params_t params = {0};
+    params.cfs = *config;
+    engine_run(ps, &policy_cfs, &params, timeline);
+}
@@ -0,0 +1,266 @@
+/*
+ * bench.c
+ *
+ * Microbenchmarks for the scheduling policies, the workload loader and the
+ * metrics pass. Every case runs on seeded synthetic workloads at several sizes
+ * and burst distributions, with warm-up runs before the timed repeats.
+ * A table goes to stdout and the raw numbers to a JSON file, so runs of two
+ * versions can be diffed for regressions. With -p each timed run is also
+ * wrapped in hardware counters (cycles, instructions, L1D/LLC misses, branch
+ * misses), reported per operation, to tell cache or branch trouble apart from
+ * plain instruction count.
+ *
+ * Usage examples:
+ *   make bench                          (n = 10^3 .. 10^6, writes bench.json)
+ *   ./build/bench -n 100000 -r 3 -o quick.json
+ *   ./build/bench -n 100000 -p          (needs perf_event_paranoid <= 2)
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "process_store.h"
+#include "algorithms.h"
+#include "metrics.h"
+#include "perf_counters.h"
+#include "timeline.h"
+#include "workload.h"
+#include "workload_gen.h"
+
+#define BENCH_RR_QUANTUM 3
+#define BENCH_MAX_N 100000000     // largest -n whose size loop (n *= 10) stays within int
+
+static int bench_mlfq_quantums[3] = {4, 8, 16};
+static mlfq_config_t bench_mlfq = {3, bench_mlfq_quantums, 50};
+static priority_config_t bench_prio = {1, 50};
+static cfs_config_t bench_cfs = {CFS_DEFAULT_LATENCY, CFS_DEFAULT_GRANULARITY};
+
+typedef struct {
+    const char *name;
+    burst_dist_t burst;
+} bench_dist_t;
+
+static const bench_dist_t dists[] = {
+    {"exp", BURST_EXPONENTIAL},
+    {"bimodal", BURST_BIMODAL},
+    {"pareto", BURST_PARETO},
+};
+#define NUM_DISTS (int)(sizeof(dists) / sizeof(dists[0]))
+
+typedef enum {
+    CASE_FIFO, CASE_SJF, CASE_STCF, CASE_RR, CASE_MLFQ, CASE_PRIO, CASE_LOTTERY, CASE_STRIDE, CASE_CFS, CASE_METRICS, CASE_LOAD
+} bench_case_t;
+
+static const char *case_names[] = {
+    "schedule_fifo", "schedule_sjf", "schedule_stcf", "schedule_rr", "schedule_mlfq", "schedule_priority",
+    "schedule_lottery", "schedule_stride", "schedule_cfs",
+    "calculate_metrics", "load_workload"
+};
+#define NUM_CASES (int)(sizeof(case_names) / sizeof(case_names[0]))
+
+typedef struct {
+    const process_t *processes;
+    int n;
+    process_store_t *store;
+    const char *path;           // text copy of the workload, for CASE_LOAD
+    sim_time_t total_time;      // from the last policy run, for CASE_METRICS
+} bench_input_t;
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/* One run of case c. Returns its scheduling decisions (timeline events), or processes for non-policy cases. */
+static long run_case(bench_case_t c, bench_input_t *in) {
+    timeline_callback_t counter;
+    timeline_callback_init(&counter, NULL, NULL);
+    switch (c) {
+        case CASE_FIFO: schedule_fifo(in->store, &counter.base); break;
+        case CASE_SJF:  schedule_sjf(in->store, &counter.base); break;
+        case CASE_STCF: schedule_stcf(in->store, &counter.base); break;
+        case CASE_RR:   schedule_rr(in->store, BENCH_RR_QUANTUM, &counter.base); break;
+        case CASE_MLFQ: schedule_mlfq(in->store, &bench_mlfq, &counter.base); break;
+        case CASE_PRIO: schedule_priority(in->store, &bench_prio, &counter.base); break;
+        case CASE_LOTTERY: schedule_lottery(in->store, BENCH_RR_QUANTUM, LOTTERY_DEFAULT_SEED, &counter.base); break;
+        case CASE_STRIDE: schedule_stride(in->store, BENCH_RR_QUANTUM, &counter.base); break;
+        case CASE_CFS:  schedule_cfs(in->store, &bench_cfs, &counter.base); break;
+        case CASE_METRICS: {
+            metrics_t m;
+            calculate_metrics(in->store, in->total_time, &m);
+            return in->n;
+        }
+        case CASE_LOAD: {
+            process_t *loaded = NULL;
+            int count = load_workload(in->path, &loaded);
+            free(loaded);
+            return count;
+        }
+    }
+    in->total_time = counter.base.total_time;
+    return counter.base.events;
+}
+
+static int cmp_double(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+typedef struct {
+    bench_case_t c;
+    const char *dist;
+    int n;
+    long ops;                   // decisions for policies, processes otherwise
+    double median_ns;
+    double min_ns;
+    double perf[PERF_NUM_COUNTERS];  // summed over the timed runs, -1 = not measured
+} bench_result_t;
+
+/* Counter total of a result per operation, or -1 if not measured. */
+static double per_op(const bench_result_t *r, int k, int repeats) {
+    if (r->perf[k] < 0 || r->ops <= 0) return -1;
+    return r->perf[k] / ((double)r->ops * repeats);
+}
+
+static void print_per_op(double v) {
+    if (v < 0) printf(" %10s", "-");
+    else printf(" %10.2f", v);
+}
+
+static void usage(const char *prog) {
+    printf("Usage: %s [options]\n", prog);
+    printf("  -n <max>      largest workload; sizes are 10^3, 10^4, ... up to max (default 1000000, at most 100000000)\n");
+    printf("  -r <repeats>  timed runs per case (default 5)\n");
+    printf("  -w <warmup>   untimed runs before them (default 1)\n");
+    printf("  -s <seed>     workload seed (default 1)\n");
+    printf("  -o <file>     JSON output (default bench.json)\n");
+    printf("  -p            also read hardware counters (cycles, instructions, cache and branch misses)\n");
+}
+
+int main(int argc, char **argv) {
+    int max_n = 1000000, repeats = 5, warmup = 1, use_perf = 0;
+    unsigned long long seed = 1;
+    const char *out = "bench.json";
+    int opt;
+    while ((opt = getopt(argc, argv, "n:r:w:s:o:ph")) != -1) {
+        switch (opt) {
+            case 'n': max_n = atoi(optarg); break;
+            case 'r': repeats = atoi(optarg); break;
+            case 'w': warmup = atoi(optarg); break;
+            case 's': seed = strtoull(optarg, NULL, 10); break;
+            case 'o': out = optarg; break;
+            case 'p': use_perf = 1; break;
+            default:
+                usage(argv[0]);
+                return 1;
+        }
+    }
+    if (max_n < 1000 || max_n > BENCH_MAX_N || repeats <= 0 || warmup < 0) { usage(argv[0]); return 3; }
+
+    int num_sizes = 0;
+    for (int n = 1000; n <= max_n; n *= 10) num_sizes++;
+    bench_result_t *results = malloc(sizeof(bench_result_t) * num_sizes * NUM_DISTS * NUM_CASES);
+    double *samples = malloc(sizeof(double) * repeats);
+    if (!results || !samples) { perror("malloc"); return 5; }
+    int count = 0;
+
+    perf_counters_t pc;
+    if (use_perf && perf_counters_open(&pc) == 0) {
+        fprintf(stderr, "bench: hardware counters unavailable (no PMU access, see kernel.perf_event_paranoid); timing only\n");
+        use_perf = 0;
+    }
+
+    char path[] = "/tmp/bench_workloadXXXXXX";
+    int fd = mkstemp(path);
+    if (fd < 0) { perror("mkstemp"); return 5; }
+    close(fd);
+
+    printf("%-18s %-8s %8s %10s %14s %14s %10s", "case", "dist", "n", "ops", "median ms", "min ms", "ns/op");
+    if (use_perf)
+        printf(" %10s %10s %10s %10s %10s", "cyc/op", "ins/op", "l1d/op", "llc/op", "brmiss/op");
+    printf("\n");
+    for (int n = 1000; n <= max_n; n *= 10) {
+        for (int d = 0; d < NUM_DISTS; ++d) {
+            workload_gen_config_t cfg;
+            workload_gen_defaults(&cfg);
+            cfg.count = n;
+            cfg.seed = seed;
+            cfg.burst = dists[d].burst;
+            process_t *processes = NULL;
+            if (generate_workload(&cfg, &processes) != n) { unlink(path); return 5; }
+            process_store_t store;
+            if (process_store_init(&store, processes, n) != 0 ||
+                write_workload(path, processes, n) != 0) { unlink(path); return 5; }
+            bench_input_t in = { processes, n, &store, path, 0 };
+
+            for (int c = 0; c < NUM_CASES; ++c) {
+                long ops = 0;
+                bench_result_t *r = &results[count++];
+                for (int k = 0; k < PERF_NUM_COUNTERS; ++k) r->perf[k] = -1;
+                for (int i = 0; i < warmup; ++i) ops = run_case(c, &in);
+                for (int i = 0; i < repeats; ++i) {
+                    double values[PERF_NUM_COUNTERS];
+                    if (use_perf) perf_counters_start(&pc);
+                    double t0 = now_ns();
+                    ops = run_case(c, &in);
+                    samples[i] = now_ns() - t0;
+                    if (!use_perf) continue;
+                    perf_counters_stop(&pc, values);
+                    for (int k = 0; k < PERF_NUM_COUNTERS; ++k) {
+                        if (values[k] < 0) continue;
+                        r->perf[k] = (r->perf[k] < 0 ? 0 : r->perf[k]) + values[k];
+                    }
+                }
+                qsort(samples, repeats, sizeof(double), cmp_double);
+                r->c = c;
+                r->dist = dists[d].name;
+                r->n = n;
+                r->ops = ops;
+                r->median_ns = samples[repeats / 2];
+                r->min_ns = samples[0];
+                printf("%-18s %-8s %8d %10ld %14.3f %14.3f %10.1f", case_names[c], r->dist, n, ops,
+                       r->median_ns / 1e6, r->min_ns / 1e6, ops > 0 ? r->median_ns / ops : 0.0);
+                if (use_perf)
+                    for (int k = 0; k < PERF_NUM_COUNTERS; ++k) print_per_op(per_op(r, k, repeats));
+                printf("\n");
+                fflush(stdout);
+            }
+            process_store_free(&store);
+            free(processes);
+        }
+    }
+    unlink(path);
+    if (use_perf) perf_counters_close(&pc);
+
+    FILE *f = fopen(out, "w");
+    if (!f) { perror("fopen"); return 5; }
+    fprintf(f, "{\n  \"seed\": %llu,\n  \"repeats\": %d,\n  \"warmup\": %d,\n  \"results\": [\n",
+            seed, repeats, warmup);
+    for (int i = 0; i < count; ++i) {
+        const bench_result_t *r = &results[i];
+        fprintf(f, "    {\"case\": \"%s\", \"dist\": \"%s\", \"n\": %d, \"op\": \"%s\", \"ops\": %ld, "
+                "\"median_ns\": %.0f, \"min_ns\": %.0f, \"ns_per_op\": %.2f",
+                case_names[r->c], r->dist, r->n, r->c <= CASE_CFS ? "decision" : "process",
+                r->ops, r->median_ns, r->min_ns,
+                r->ops > 0 ? r->median_ns / r->ops : 0.0);
+        if (use_perf) {
+            // per operation, null where the counter could not be read
+            for (int k = 0; k < PERF_NUM_COUNTERS; ++k) {
+                double v = per_op(r, k, repeats);
+                if (v < 0) fprintf(f, ", \"%s_per_op\": null", perf_counter_name(k));
+                else fprintf(f, ", \"%s_per_op\": %.3f", perf_counter_name(k), v);
+            }
+        }
+        fprintf(f, "}%s\n", i + 1 < count ? "," : "");
+    }
+    fprintf(f, "  ]\n}\n");
+    fclose(f);
+    printf("Results written to %s\n", out);
+    free(results);
+    free(samples);
+    return 0;
+}
@@ -0,0 +1,69 @@
+/*
+ * checkpoint.c
+ *
+ * Varint byte stream used by engine checkpoints: zigzag LEB128 values, a
+ * running FNV-1a hash and a sticky error flag.
+ */
+
+#include "checkpoint.h"
+
+#define FNV_OFFSET 1469598103934665603ULL
+#define FNV_PRIME  1099511628211ULL
+
+void ckpt_open(ckpt_stream_t *s, FILE *f) {
+    s->f = f;
+    s->hash = FNV_OFFSET;
+    s->err = 0;
+}
+
+static void put_byte(ckpt_stream_t *s, unsigned char b) {
+    if (s->err) return;
+    if (fputc(b, s->f) == EOF) { s->err = 1; return; }
+    s->hash = (s->hash ^ b) * FNV_PRIME;
+}
+
+static unsigned char get_byte(ckpt_stream_t *s) {
+    if (s->err) return 0;
+    int c = fgetc(s->f);
+    if (c == EOF) { s->err = 1; return 0; }
+    s->hash = (s->hash ^ (unsigned char)c) * FNV_PRIME;
+    return (unsigned char)c;
+}
+
+void ckpt_put(ckpt_stream_t *s, long long v) {
+    // zigzag: 0, -1, 1, -2, ... map to 0, 1, 2, 3, ...
+    uint64_t u = ((uint64_t)v << 1) ^ (uint64_t)(v >> 63);
+    while (u >= 0x80) {
+        put_byte(s, (unsigned char)(u | 0x80));
+        u >>= 7;
+    }
+    put_byte(s, (unsigned char)u);
+}
+
+long long ckpt_get(ckpt_stream_t *s) {
+    uint64_t u = 0;
+    for (int shift = 0; !s->err; shift += 7) {
+        if (shift > 63) { s->err = 1; break; }
+        unsigned char b = get_byte(s);
+        u |= (uint64_t)(b & 0x7f) << shift;
+        if (!(b & 0x80)) break;
+    }
+    if (s->err) return 0;
+    return (long long)(u >> 1) ^ -(long long)(u & 1);
+}
+
+long long ckpt_get_range(ckpt_stream_t *s, long long lo, long long hi) {
+    long long v = ckpt_get(s);
+    if (v < lo || v > hi) { s->err = 1; return lo; }
+    return v;
+}
+
+void ckpt_put_bytes(ckpt_stream_t *s, const void *data, size_t len) {
+    const unsigned char *p = data;
+    for (size_t i = 0; i < len; ++i) put_byte(s, p[i]);
+}
+
+void ckpt_get_bytes(ckpt_stream_t *s, void *data, size_t len) {
+    unsigned char *p = data;
+    for (size_t i = 0; i < len; ++i) p[i] = get_byte(s);
+}
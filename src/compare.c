@@ -0,0 +1,86 @@
+/*
+ * compare.c
+ *
+ * Runs the report's algorithm comparison concurrently. Each policy gets its
+ * own thread and its own process store built from the shared array; results
+ * land in separate entries, so no locking is needed.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include "compare.h"
+#include "engine.h"
+#include "timeline.h"
+
+typedef struct {
+    const process_t *processes;
+    int n;
+    int slot;
+    compare_entry_t *entry;
+    int failed;                 // store, accumulator or run failed; entry not filled in
+} compare_job_t;
+
+void compare_init(compare_entry_t *entries) {
+    for (int i = 0; i < COMPARE_NUM_ALGS; ++i) {
+        entries[i].name = policy_get(i)->report_name;
+        entries[i].precomputed = 0;
+        entries[i].failed = 0;
+        memset(&entries[i].metrics, 0, sizeof(metrics_t));
+        memset(&entries[i].stats, 0, sizeof(sched_stats_t));
+    }
+}
+
+int compare_find(const char *alg, const policy_params_t *params) {
+    int slot = policy_find(alg);
+    if (slot < 0 || !policy_params_equal(&policy_get(slot)->report, params)) return -1;
+    return slot;
+}
+
+int compare_run_slot(int slot, process_store_t *ps, timeline_sink_t *sink) {
+    const policy_entry_t *entry = policy_get(slot);
+    return engine_run(ps, entry->ops, &entry->report, sink);
+}
+
+static void *compare_worker(void *arg) {
+    compare_job_t *job = arg;
+    process_store_t store;
+    metrics_acc_t acc;
+    if (process_store_init(&store, job->processes, job->n) != 0) { job->failed = 1; return NULL; }
+    if (metrics_acc_init(&acc) != 0) { process_store_free(&store); job->failed = 1; return NULL; }
+    store.acc = &acc;   // metrics are accumulated during the run
+    store.stats = &job->entry->stats;
+    // only total time is needed here, so count events without storing them
+    timeline_callback_t counter;
+    timeline_callback_init(&counter, NULL, NULL);
+    if (compare_run_slot(job->slot, &store, &counter.base) != 0) job->failed = 1;
+    else metrics_acc_snapshot(&acc, counter.base.total_time, &job->entry->metrics);
+    metrics_acc_free(&acc);
+    process_store_free(&store);
+    return NULL;
+}
+
+int run_comparison(const process_t *processes, int n, compare_entry_t *entries) {
+    pthread_t threads[COMPARE_NUM_ALGS];
+    compare_job_t jobs[COMPARE_NUM_ALGS];
+    int started[COMPARE_NUM_ALGS] = {0};
+    for (int i = 0; i < COMPARE_NUM_ALGS; ++i) {
+        if (entries[i].precomputed) continue;
+        jobs[i].processes = processes;
+        jobs[i].n = n;
+        jobs[i].slot = i;
+        jobs[i].entry = &entries[i];
+        jobs[i].failed = 0;
+        if (pthread_create(&threads[i], NULL, compare_worker, &jobs[i]) == 0) started[i] = 1;
+        else compare_worker(&jobs[i]);  // no thread available, run inline
+    }
+    int failed = 0;
+    for (int i = 0; i < COMPARE_NUM_ALGS; ++i) {
+        if (started[i]) pthread_join(threads[i], NULL);
+        if (entries[i].precomputed) continue;
+        entries[i].failed = jobs[i].failed;
+        failed += jobs[i].failed;
+    }
+    return failed ? -1 : 0;
+}
@@ -0,0 +1,35 @@
+/*
+ * convert_workload.c
+ *
+ * Converts workloads between the text and binary formats. The input format
+ * is detected; the output is binary when its name ends in ".bin", text otherwise.
+ *
+ * Usage examples:
+ *   ./convert_workload workloads/big.txt workloads/big.bin
+ *   ./convert_workload workloads/big.bin big_again.txt
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "workload.h"
+
+int main(int argc, char **argv) {
+    if (argc < 3) {
+        printf("Usage: %s <input_workload> <output_workload>\n", argv[0]);
+        printf("Output is binary if its name ends in .bin, text otherwise.\n");
+        return 1;
+    }
+    process_t *processes = NULL;
+    int n = load_workload(argv[1], &processes);
+    if (n < 0) return 2;
+
+    size_t len = strlen(argv[2]);
+    int binary = (len >= 4 && strcmp(argv[2] + len - 4, ".bin") == 0);
+    int rc = binary ? write_workload_bin(argv[2], processes, n) : write_workload(argv[2], processes, n);
+    free(processes);
+    if (rc != 0) return 5;
+    printf("Converted %d processes into %s (%s)\n", n, argv[2], binary ? "binary" : "text");
+    return 0;
+}
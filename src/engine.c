@@ -0,0 +1,319 @@
+/*
+ * engine.c
+ *
+ * Event-driven simulation core shared by all single-CPU policies. Arrivals
+ * come from an arrival-sorted cursor (or, in stream mode, from a source that
+ * admits them into a growing store) and are queued exactly once, so arrival
+ * pushes are added up from the cursor at the end; the policy callbacks only
+ * manage their own queues. A run can pause between events and be written to
+ * or restored from a checkpoint.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "engine.h"
+#include "ready_queue.h"
+
+/* helper: find first arrival time among processes (min arrival) */
+static sim_time_t first_arrival(const process_hot_t *hot, int n) {
+    if (n == 0) return 0;
+    sim_time_t mn = hot[0].arrival_time;
+    for (int i = 1; i < n; ++i) if (hot[i].arrival_time < mn) mn = hot[i].arrival_time;
+    return mn;
+}
+
+static int start(engine_t *e, process_store_t *ps, const sched_policy_t *policy, const policy_params_t *params,
+                 engine_source_t *source) {
+    process_store_reset(ps);
+    e->ps = ps;
+    e->policy = policy;
+    e->source = source;
+    if (source) {
+        sim_time_t first = source->peek(source);
+        e->time = first >= 0 ? first : 0;
+        e->order = NULL;
+    } else {
+        e->time = first_arrival(ps->hot, ps->n);
+        e->order = arrival_order(ps->hot, ps->n);
+    }
+    e->state = calloc(1, policy->state_size > 0 ? policy->state_size : 1);
+    if ((!source && !e->order) || !e->state || policy->init(e->state, ps, params, e->time) != 0) {
+        free(e->order);
+        free(e->state);
+        e->order = NULL;
+        e->state = NULL;
+        return -1;
+    }
+    e->next = 0;
+    e->completed = 0;
+    e->cur = -1;
+    e->cur_start = 0;
+    e->budget = 0;
+    e->done = 0;
+    return 0;
+}
+
+int engine_start(engine_t *e, process_store_t *ps, const sched_policy_t *policy, const policy_params_t *params) {
+    return start(e, ps, policy, params, NULL);
+}
+
+int engine_start_stream(engine_t *e, process_store_t *ps, const sched_policy_t *policy,
+                        const policy_params_t *params, engine_source_t *source) {
+    if (!policy->grow) {
+        fprintf(stderr, "policy %s does not support streamed runs\n", policy->name);
+        return -1;
+    }
+    return start(e, ps, policy, params, source);
+}
+
+void engine_free(engine_t *e) {
+    if (e->state && e->policy->destroy) e->policy->destroy(e->state);
+    free(e->state);
+    free(e->order);
+    e->state = NULL;
+    e->order = NULL;
+}
+
+/* Arrival time of the next process not queued yet, or -1 if none is left. */
+static sim_time_t pending_arrival(const engine_t *e) {
+    if (e->source) return e->source->peek(e->source);
+    return e->next < e->ps->n ? e->ps->hot[e->order[e->next]].arrival_time : -1;
+}
+
+/* Queue every process that has arrived by time. Returns 0, or -1 if a streamed one could not be admitted. */
+static int queue_arrivals(engine_t *e, sim_time_t time) {
+    sim_time_t at;
+    while ((at = pending_arrival(e)) >= 0 && at <= time) {
+        int idx;
+        if (e->source) {
+            int slots = e->ps->n;
+            idx = e->source->admit(e->source, e->ps);
+            if (idx < 0) return -1;
+            if (e->ps->n != slots && e->policy->grow(e->state, e->ps) != 0) return -1;
+        } else {
+            idx = e->order[e->next++];
+        }
+        e->policy->enqueue(e->state, idx, at);
+    }
+    return 0;
+}
+
+int engine_advance(engine_t *e, sim_time_t until, timeline_sink_t *timeline) {
+    if (e->done) return 1;
+    const sched_policy_t *policy = e->policy;
+    void *state = e->state;
+    process_store_t *ps = e->ps;
+    sched_stats_t *st = ps->stats;
+    long events0 = timeline->events;
+    int preemptive = policy->preempt != NULL;
+    // the loop works on locals; they go back into e when it stops. A streamed run has no
+    // process count: it ends when nothing is runnable and nothing is left to arrive.
+    int completed = e->completed, cur = e->cur, stalled = 0, failed = 0;
+    sim_time_t time = e->time, cur_start = e->cur_start, budget = e->budget;
+    while (e->source || completed < ps->n) {
+        if (time >= until) break;
+        if (queue_arrivals(e, time) != 0) { failed = 1; break; }
+        if (cur == -1) {
+            cur = policy->pick_next(state, time);
+            if (cur == -1) {
+                // idle until next arrival
+                sim_time_t next_arr = pending_arrival(e);
+                if (next_arr < 0) { stalled = 1; break; }    // nothing runnable and nothing left to arrive
+                timeline_emit(timeline, time, -1, next_arr - time);
+                SCHED_COUNT(st, idle_gaps, 1);
+                time = next_arr;
+                continue;
+            }
+            SCHED_COUNT(st, queue_pops, 1);
+            SCHED_COUNT(st, dispatches, 1);
+            cur_start = time;
+            if (ps->cold[cur].start_time == -1) ps->cold[cur].start_time = time;
+            budget = policy->slice(state, cur, time);
+        }
+        // run until completion, the end of the slice or (if preemptive) the next arrival
+        process_hot_t *p = &ps->hot[cur];
+        sim_time_t run = (p->remaining_time < budget) ? p->remaining_time : budget;
+        if (preemptive) {
+            sim_time_t next_arr = pending_arrival(e);
+            if (next_arr >= 0 && next_arr - time < run) run = next_arr - time;
+        }
+        p->remaining_time -= run;
+        time += run;
+        if (budget != SLICE_UNLIMITED) budget -= run;
+        if (policy->on_tick) policy->on_tick(state, cur, run, time);
+        // a completed process is retired first, so a streamed arrival at this instant can reuse its slot
+        if (p->remaining_time == 0) {
+            timeline_emit(timeline, cur_start, p->pid, time - cur_start);
+            process_store_complete(ps, cur, time);
+            if (policy->on_complete) policy->on_complete(state, cur, time);
+            if (e->source) e->source->retire(e->source, ps, cur, time);
+            else completed++;
+            cur = -1;
+        }
+        // processes that arrived meanwhile are queued ahead of a requeued one
+        if (queue_arrivals(e, time) != 0) { failed = 1; break; }
+        if (cur == -1) continue;
+        p = &ps->hot[cur];      // a streamed arrival may have grown the store
+        if (budget == 0 || (preemptive && policy->preempt(state, cur, time))) {
+            timeline_emit(timeline, cur_start, p->pid, time - cur_start);
+            policy->requeue(state, cur, time - cur_start, time);
+            SCHED_COUNT(st, queue_pushes, 1);
+            SCHED_COUNT(st, preemptions, 1);
+            cur = -1;
+        } else {
+            budget = policy->slice(state, cur, time);
+        }
+    }
+    e->completed = completed;
+    e->cur = cur;
+    e->time = time;
+    e->cur_start = cur_start;
+    e->budget = budget;
+    e->done = (!e->source && completed >= ps->n) || stalled || failed;
+    if (e->done) SCHED_COUNT(st, queue_pushes, e->next);
+    SCHED_COUNT(st, timeline_events, timeline->events - events0);
+    timeline_flush(timeline);
+    return failed ? -1 : e->done;
+}
+
+int engine_run(process_store_t *ps, const sched_policy_t *policy, const policy_params_t *params,
+               timeline_sink_t *timeline) {
+    engine_t e;
+    if (engine_start(&e, ps, policy, params) != 0) return -1;
+    engine_advance(&e, SLICE_UNLIMITED, timeline);
+    engine_free(&e);
+    return 0;
+}
+
+/* FNV-1a over the fields that define the workload, so a checkpoint is not resumed against another one */
+static uint64_t workload_fingerprint(const process_store_t *ps) {
+    uint64_t h = 1469598103934665603ULL;
+    for (int i = 0; i < ps->n; ++i) {
+        const process_hot_t *p = &ps->hot[i];
+        long long fields[4] = {p->arrival_time, p->burst_time, p->pid, p->priority};
+        for (int k = 0; k < 4; ++k) h = (h ^ (uint64_t)fields[k]) * 1099511628211ULL;
+    }
+    return h;
+}
+
+int engine_checkpoint(const engine_t *e, const timeline_sink_t *timeline, FILE *out) {
+    const process_store_t *ps = e->ps;
+    if (e->source) {
+        fprintf(stderr, "streamed runs cannot be checkpointed\n");
+        return -1;
+    }
+    if (!e->policy->save) {
+        fprintf(stderr, "policy %s does not support checkpoints\n", e->policy->name);
+        return -1;
+    }
+    ckpt_stream_t s;
+    ckpt_open(&s, out);
+    static const char magic[8] = CKPT_MAGIC;
+    ckpt_put_bytes(&s, magic, sizeof(magic));
+    ckpt_put(&s, CKPT_VERSION);
+    size_t name_len = strlen(e->policy->name);
+    ckpt_put(&s, (long long)name_len);
+    ckpt_put_bytes(&s, e->policy->name, name_len);
+    ckpt_put(&s, ps->n);
+    ckpt_put(&s, (long long)workload_fingerprint(ps));
+
+    ckpt_put(&s, e->time);
+    ckpt_put(&s, e->next);
+    ckpt_put(&s, e->completed);
+    ckpt_put(&s, e->cur);
+    ckpt_put(&s, e->cur_start);
+    ckpt_put(&s, e->budget);
+    ckpt_put(&s, timeline->events);
+    ckpt_put(&s, timeline->total_time);
+    sched_stats_t none = {0};
+    const sched_stats_t *st = ps->stats ? ps->stats : &none;
+    long long counters[9] = {st->dispatches, st->queue_pushes, st->queue_pops, st->candidate_scans,
+                             st->preemptions, st->idle_gaps, st->demotions, st->boosts, st->timeline_events};
+    for (int k = 0; k < 9; ++k) ckpt_put(&s, counters[k]);
+
+    // work done rather than remaining time: 0 for every process that has not run yet
+    for (int i = 0; i < ps->n; ++i) {
+        ckpt_put(&s, ps->hot[i].burst_time - ps->hot[i].remaining_time);
+        ckpt_put(&s, ps->cold[i].start_time);
+        ckpt_put(&s, ps->cold[i].completion_time);
+    }
+    e->policy->save(e->state, &s);
+    ckpt_put(&s, (long long)s.hash);
+    if (s.err || fflush(out) != 0) {
+        perror("checkpoint");
+        return -1;
+    }
+    return 0;
+}
+
+int engine_resume(engine_t *e, process_store_t *ps, const sched_policy_t *policy,
+                  const policy_params_t *params, timeline_sink_t *timeline, FILE *in) {
+    if (!policy->load) {
+        fprintf(stderr, "policy %s does not support checkpoints\n", policy->name);
+        return -1;
+    }
+    ckpt_stream_t s;
+    ckpt_open(&s, in);
+    char magic[8];
+    ckpt_get_bytes(&s, magic, sizeof(magic));
+    if (s.err || memcmp(magic, CKPT_MAGIC, sizeof(magic)) != 0 || ckpt_get(&s) != CKPT_VERSION) {
+        fprintf(stderr, "not a checkpoint file (or an unsupported version)\n");
+        return -1;
+    }
+    char name[64];
+    size_t name_len = (size_t)ckpt_get_range(&s, 0, sizeof(name) - 1);
+    ckpt_get_bytes(&s, name, name_len);
+    name[name_len] = '\0';
+    if (s.err || strcmp(name, policy->name) != 0) {
+        fprintf(stderr, "checkpoint was taken under policy %s, not %s\n", name, policy->name);
+        return -1;
+    }
+    if (ckpt_get(&s) != ps->n || (uint64_t)ckpt_get(&s) != workload_fingerprint(ps)) {
+        fprintf(stderr, "checkpoint was taken on a different workload\n");
+        return -1;
+    }
+    if (engine_start(e, ps, policy, params) != 0) return -1;
+    int n = ps->n;
+
+    e->time = ckpt_get(&s);
+    e->next = (int)ckpt_get_range(&s, 0, n);
+    e->completed = (int)ckpt_get_range(&s, 0, n);
+    e->cur = (int)ckpt_get_range(&s, -1, n - 1);
+    e->cur_start = ckpt_get(&s);
+    e->budget = ckpt_get_range(&s, 0, SLICE_UNLIMITED);
+    e->done = e->completed >= n;
+    timeline->events = (long)ckpt_get_range(&s, 0, SLICE_UNLIMITED);
+    timeline->total_time = ckpt_get_range(&s, 0, SLICE_UNLIMITED);
+    long long counters[9];
+    for (int k = 0; k < 9; ++k) counters[k] = ckpt_get(&s);
+    if (ps->stats) {
+        sched_stats_t *st = ps->stats;
+        st->dispatches = counters[0];
+        st->queue_pushes = counters[1];
+        st->queue_pops = counters[2];
+        st->candidate_scans = counters[3];
+        st->preemptions = counters[4];
+        st->idle_gaps = counters[5];
+        st->demotions = counters[6];
+        st->boosts = counters[7];
+        st->timeline_events = counters[8];
+    }
+
+    for (int i = 0; i < n && !s.err; ++i) {
+        process_hot_t *h = &ps->hot[i];
+        h->remaining_time = h->burst_time - ckpt_get_range(&s, 0, h->burst_time);
+        ps->cold[i].start_time = ckpt_get(&s);
+        sim_time_t completion = ckpt_get(&s);
+        if (completion >= 0) process_store_complete(ps, i, completion);
+    }
+    policy->load(e->state, n, &s);
+    uint64_t expected = s.hash;
+    if (!s.err && (uint64_t)ckpt_get(&s) != expected) s.err = 1;
+    if (s.err) {
+        fprintf(stderr, "checkpoint is truncated or corrupt\n");
+        engine_free(e);
+        return -1;
+    }
+    return 0;
+}
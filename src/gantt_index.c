@@ -0,0 +1,152 @@
+/*
+ * gantt_index.c
+ *
+ * Segment tree of per-bucket busy time and dominant pid over a timeline, so
+ * the Gantt view can draw any zoom level of a million-event timeline in time
+ * proportional to the screen width.
+ */
+
+#include <stdlib.h>
+#include "gantt_index.h"
+
+/* Weighted majority vote (Misra-Gries with one counter): mergeable, so tree nodes combine exactly like leaves. */
+static void vote(int *pid, sim_time_t *weight, int p, sim_time_t w) {
+    if (*pid == p || *weight == 0) {
+        if (*pid != p) *pid = p;
+        *weight += w;
+    } else if (*weight >= w) {
+        *weight -= w;
+    } else {
+        *pid = p;
+        *weight = w - *weight;
+    }
+}
+
+static void merge(gantt_node_t *into, const gantt_node_t *from) {
+    into->busy += from->busy;
+    if (from->pid != -1) vote(&into->pid, &into->weight, from->pid, from->weight);
+}
+
+int gantt_index_build(gantt_index_t *g, const timeline_event_t *events, int len) {
+    g->events = events;
+    g->len = len;
+    g->origin = len > 0 ? events[0].time : 0;
+    g->end = len > 0 ? events[len - 1].time + events[len - 1].duration : 0;
+    sim_time_t span = g->end - g->origin;
+    if (span < 1) span = 1;
+    g->leaves = 1;
+    while (g->leaves < span && g->leaves < GANTT_MAX_LEAVES) g->leaves <<= 1;
+    g->leaf_width = (span + g->leaves - 1) / g->leaves;
+    g->tree = calloc((size_t)2 * g->leaves, sizeof(gantt_node_t));
+    if (!g->tree) return -1;
+    for (int i = 0; i < 2 * g->leaves; ++i) g->tree[i].pid = -1;
+    // events do not overlap, so all events together touch at most len + leaves leaves
+    gantt_node_t *leaf = g->tree + g->leaves;
+    sim_time_t lw = g->leaf_width;
+    for (int k = 0; k < len; ++k) {
+        if (events[k].pid == -1 || events[k].duration <= 0) continue;
+        sim_time_t s = events[k].time - g->origin;
+        sim_time_t e = s + events[k].duration;
+        for (sim_time_t i = s / lw; i <= (e - 1) / lw; ++i) {
+            sim_time_t lo = i * lw > s ? i * lw : s;
+            sim_time_t hi = (i + 1) * lw < e ? (i + 1) * lw : e;
+            leaf[i].busy += hi - lo;
+            vote(&leaf[i].pid, &leaf[i].weight, events[k].pid, hi - lo);
+        }
+    }
+    for (int i = g->leaves - 1; i >= 1; --i) {
+        g->tree[i] = g->tree[2 * i];
+        merge(&g->tree[i], &g->tree[2 * i + 1]);
+    }
+    return 0;
+}
+
+void gantt_index_free(gantt_index_t *g) {
+    free(g->tree);
+    g->tree = NULL;
+}
+
+/* left edge of column c of a width-column view of [t0, t1) */
+static sim_time_t column_start(sim_time_t t0, sim_time_t t1, int width, int c) {
+    return t0 + (sim_time_t)((__int128)(t1 - t0) * c / width);
+}
+
+/* first event ending after t; events are sorted and disjoint, so ends are sorted too */
+static int first_ending_after(const gantt_index_t *g, sim_time_t t) {
+    int lo = 0, hi = g->len;
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        if (g->events[mid].time + g->events[mid].duration > t) hi = mid;
+        else lo = mid + 1;
+    }
+    return lo;
+}
+
+static int first_starting_at(const gantt_index_t *g, sim_time_t t) {
+    int lo = 0, hi = g->len;
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        if (g->events[mid].time >= t) hi = mid;
+        else lo = mid + 1;
+    }
+    return lo;
+}
+
+/* leaf boundary at or after t, clamped to [0, leaves] */
+static sim_time_t leaf_ceil(const gantt_index_t *g, sim_time_t t) {
+    if (t <= g->origin) return 0;
+    sim_time_t i = (t - g->origin + g->leaf_width - 1) / g->leaf_width;
+    return i > g->leaves ? g->leaves : i;
+}
+
+void gantt_index_sample(const gantt_index_t *g, sim_time_t t0, sim_time_t t1, int width, gantt_cell_t *cells) {
+    if (width <= 0) return;
+    for (int c = 0; c < width; ++c) {
+        cells[c].pid = -1;
+        cells[c].busy = 0;
+        cells[c].span = column_start(t0, t1, width, c + 1) - column_start(t0, t1, width, c);
+    }
+    if (t1 <= t0 || g->len == 0) return;
+    int lo = first_ending_after(g, t0);
+    int hi = first_starting_at(g, t1);
+    if (hi - lo <= 4 * width) {
+        // few events in view: distribute each one over the columns it covers
+        sim_time_t weight[width];
+        for (int c = 0; c < width; ++c) weight[c] = 0;
+        int c = 0;
+        for (int k = lo; k < hi; ++k) {
+            const timeline_event_t *ev = &g->events[k];
+            if (ev->pid == -1) continue;
+            sim_time_t s = ev->time > t0 ? ev->time : t0;
+            sim_time_t e = ev->time + ev->duration < t1 ? ev->time + ev->duration : t1;
+            while (s < e) {
+                while (c + 1 < width && column_start(t0, t1, width, c + 1) <= s) c++;
+                sim_time_t col_end = column_start(t0, t1, width, c + 1);
+                sim_time_t part = (col_end < e ? col_end : e) - s;
+                cells[c].busy += part;
+                vote(&cells[c].pid, &weight[c], ev->pid, part);
+                s += part;
+            }
+        }
+        return;
+    }
+    // dense view: each column is a range of whole leaves, answered from O(log leaves) tree nodes
+    for (int c = 0; c < width; ++c) {
+        sim_time_t cs = column_start(t0, t1, width, c);
+        sim_time_t l = leaf_ceil(g, cs);
+        sim_time_t r = leaf_ceil(g, column_start(t0, t1, width, c + 1));
+        if (l >= r) {
+            // column narrower than a leaf: show the leaf it starts in
+            l = cs <= g->origin ? 0 : (cs - g->origin) / g->leaf_width;
+            if (l >= g->leaves) continue;
+            r = l + 1;
+        }
+        gantt_node_t acc = {0, 0, -1};
+        for (sim_time_t a = l + g->leaves, b = r + g->leaves; a < b; a >>= 1, b >>= 1) {
+            if (a & 1) merge(&acc, &g->tree[a++]);
+            if (b & 1) merge(&acc, &g->tree[--b]);
+        }
+        cells[c].pid = acc.pid;
+        cells[c].busy = acc.busy < cells[c].span ? acc.busy : cells[c].span;
+    }
+}
@@ -1,120 +1,192 @@
-#include <ncurses.h>
-#include <stdio.h>
-#include <stdlib.h>
-#include <string.h>
-#include "scheduler.h"
-#include "metrics.h"
-
-static void draw_horizontal_line(int y, int x_start, int x_end) {
-    for (int x = x_start; x <= x_end; ++x) {
-        mvaddch(y, x, '-');
-    }
-}
-
-static void draw_box_ascii(int y, int x, int h, int w, const char *title) {
-    mvaddch(y, x, '+');
-    mvaddch(y, x + w - 1, '+');
-    mvaddch(y + h - 1, x, '+');
-    mvaddch(y + h - 1, x + w - 1, '+');
-
-    for (int i = 1; i < w - 1; ++i) {
-        mvaddch(y, x + i, '-');
-        mvaddch(y + h - 1, x + i, '-');
-    }
-    for (int i = 1; i < h - 1; ++i) {
-        mvaddch(y + i, x, '|');
-        mvaddch(y + i, x + w - 1, '|');
-    }
-
-    if (title) {
-        mvprintw(y, x + 2, "%s", title);
-    }
-}
-
-void render_gui(process_t *processes, int n, timeline_event_t *timeline, int tlen, metrics_t *metrics, const char *algorithm_name, int quantum) {
-    initscr();
-    cbreak();
-    noecho();
-    curs_set(0);
-    int rows, cols;
-    getmaxyx(stdscr, rows, cols);
-
-    // Header
-    mvprintw(0, (cols - 28)/2, "CPU Scheduler Simulator v1.0");
-    draw_horizontal_line(1, 0, cols-1);
-
-    // Process table
-    int table_y = 2;
-    int table_x = 2;
-    int table_w = 40;
-    int table_h = n + 4;
-    draw_box_ascii(table_y, table_x, table_h, table_w, "Processes");
-    mvprintw(table_y + 1, table_x + 1, "PID | Arrival | Burst | Priority");
-    for (int i = 0; i < n; ++i) {
-        mvprintw(table_y + 2 + i, table_x + 1, " %2d | %6d | %5d | %7d",
-                 processes[i].pid, processes[i].arrival_time, processes[i].burst_time, processes[i].priority);
-    }
-
-    // Algorithm info
-    int algo_y = table_y + table_h + 1;
-    mvprintw(algo_y, table_x, "Algorithm: [%s]", algorithm_name);
-    if (quantum > 0) {
-        printw("  Quantum: [%d]", quantum);
-    }
-
-    // Gantt chart
-    int gantt_y = algo_y + 2;
-    int gantt_w = cols - 4;
-    draw_box_ascii(gantt_y, table_x, 5, gantt_w, "Gantt Chart");
-
-    int total_time = 0;
-    for (int i = 0; i < tlen; ++i) total_time += timeline[i].duration;
-    double scale = (total_time > 0) ? ((double)(gantt_w - 2) / total_time) : 1.0;
-
-    int x = table_x + 1;
-    int y = gantt_y + 1;
-    int times_y = gantt_y + 3;
-    int cur_time = 0;
-
-    for (int i = 0; i < tlen; ++i) {
-        int width = (int)(timeline[i].duration * scale + 0.5);
-        if (width < 3) width = 3;
-
-        char label[8];
-        if (timeline[i].pid == -1) snprintf(label, sizeof(label), "IDLE");
-        else snprintf(label, sizeof(label), "P%d", timeline[i].pid);
-
-        // Bloque del Gantt
-        mvprintw(y, x, "|%s", label);
-        for (int k = strlen(label); k < width - 1; ++k) {
-            mvaddch(y, x + k, '=');
-        }
-        mvaddch(y, x + width - 1, '|');
-
-        // Tiempo debajo
-        mvprintw(times_y, x, "%d", cur_time);
-        cur_time += timeline[i].duration;
-
-        x += width;
-        if (x >= table_x + gantt_w - 1) break;
-    }
-    // Último tiempo al final del Gantt
-    mvprintw(times_y, x, "%d", cur_time);
-
-    // Metrics
-    int metrics_y = gantt_y + 7;
-    draw_box_ascii(metrics_y, table_x, 7, 40, "Metrics");
-    mvprintw(metrics_y + 1, table_x + 1, "Avg Turnaround: %.2f", metrics->avg_turnaround_time);
-    mvprintw(metrics_y + 2, table_x + 1, "Avg Waiting:    %.2f", metrics->avg_waiting_time);
-    mvprintw(metrics_y + 3, table_x + 1, "Avg Response:   %.2f", metrics->avg_response_time);
-    mvprintw(metrics_y + 4, table_x + 1, "CPU Utilization: %.2f%%", metrics->cpu_utilization);
-    mvprintw(metrics_y + 5, table_x + 1, "Throughput: %.4f", metrics->throughput);
-
-    // Footer
-    mvprintw(rows - 2, table_x, "[R]un  [A]dd Process  [D]elete  [S]ave  [L]oad  [Q]uit");
-
-    refresh();
-    getch();
-    endwin();
-}
-
+/*
+ * gui_ncurses.c
+ *
+ * Terminal view of a run: process table, a zoomable Gantt chart drawn from
+ * gantt_index.c, and the metrics.
+ */
+
+#include <ncurses.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "scheduler.h"
+#include "metrics.h"
+#include "gantt_index.h"
+
+static void draw_horizontal_line(int y, int x_start, int x_end) {
+    for (int x = x_start; x <= x_end; ++x) {
+        mvaddch(y, x, '-');
+    }
+}
+
+static void draw_box_ascii(int y, int x, int h, int w, const char *title) {
+    mvaddch(y, x, '+');
+    mvaddch(y, x + w - 1, '+');
+    mvaddch(y + h - 1, x, '+');
+    mvaddch(y + h - 1, x + w - 1, '+');
+
+    for (int i = 1; i < w - 1; ++i) {
+        mvaddch(y, x + i, '-');
+        mvaddch(y + h - 1, x + i, '-');
+    }
+    for (int i = 1; i < h - 1; ++i) {
+        mvaddch(y + i, x, '|');
+        mvaddch(y + i, x + w - 1, '|');
+    }
+
+    if (title) {
+        mvprintw(y, x + 2, "%s", title);
+    }
+}
+
+/* one glyph per pid so dense views stay readable: 0-9, A-Z, a-z */
+static char pid_glyph(int pid) {
+    static const char glyphs[] = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz";
+    if (pid < 0) return '.';
+    return glyphs[pid % (int)(sizeof(glyphs) - 1)];
+}
+
+/* busy share of a column as a shade, blank when idle and '#' when fully busy */
+static char load_glyph(const gantt_cell_t *cell) {
+    static const char shades[] = " .:-=#";
+    if (cell->busy <= 0 || cell->span <= 0) return ' ';
+    int level = (int)((cell->busy * 5 + cell->span - 1) / cell->span);
+    if (level > 5) level = 5;
+    return shades[level];
+}
+
+/* Gantt box: dominant pid row, utilization row and time axis for [t0, t1). */
+static void draw_gantt(int y, int x, int w, const gantt_index_t *g, sim_time_t t0, sim_time_t t1,
+                       gantt_cell_t *cells) {
+    int width = w - 2;
+    char title[96];
+    snprintf(title, sizeof(title), "Gantt Chart [%lld, %lld)", (long long)t0, (long long)t1);
+    draw_box_ascii(y, x, 6, w, title);
+    gantt_index_sample(g, t0, t1, width, cells);
+    for (int c = 0; c < width; ++c) {
+        mvaddch(y + 1, x + 1 + c, pid_glyph(cells[c].pid));
+        mvaddch(y + 2, x + 1 + c, load_glyph(&cells[c]));
+    }
+    // time labels every 12 columns, each at the start of its column
+    for (int c = 0; c + 8 < width; c += 12) {
+        mvaddch(y + 3, x + 1 + c, '|');
+        mvprintw(y + 4, x + 1 + c, "%lld", (long long)(t0 + (sim_time_t)((__int128)(t1 - t0) * c / width)));
+    }
+}
+
+void render_gui(process_t *processes, int n, timeline_event_t *timeline, int tlen, metrics_t *metrics, const char *algorithm_name, int quantum) {
+    gantt_index_t index;
+    if (gantt_index_build(&index, timeline, tlen) != 0) {
+        fprintf(stderr, "out of memory building the Gantt index\n");
+        return;
+    }
+    initscr();
+    cbreak();
+    noecho();
+    keypad(stdscr, TRUE);
+    curs_set(0);
+    int rows, cols;
+    getmaxyx(stdscr, rows, cols);
+    int cells_cap = cols > 2 ? cols : 2;
+    gantt_cell_t *cells = malloc(sizeof(gantt_cell_t) * cells_cap);
+    if (!cells) {
+        endwin();
+        gantt_index_free(&index);
+        fprintf(stderr, "out of memory\n");
+        return;
+    }
+
+    // the view never gets narrower than one time unit per column
+    sim_time_t full_t0 = index.origin, full_t1 = index.end > index.origin ? index.end : index.origin + 1;
+    sim_time_t t0 = full_t0, t1 = full_t1;
+
+    for (;;) {
+        erase();
+        getmaxyx(stdscr, rows, cols);
+        // the terminal may have been widened since the last frame
+        if (cols > cells_cap) {
+            gantt_cell_t *grown = realloc(cells, sizeof(gantt_cell_t) * cols);
+            if (grown) {
+                cells = grown;
+                cells_cap = cols;
+            }
+        }
+        sim_time_t min_span = cols - 6 > 1 ? cols - 6 : 1;
+
+        // Header
+        mvprintw(0, (cols - 28)/2, "CPU Scheduler Simulator v1.0");
+        draw_horizontal_line(1, 0, cols-1);
+
+        // Process table, cut down to whatever the Gantt and metrics leave free
+        int table_y = 2;
+        int table_x = 2;
+        int table_w = 40;
+        int shown = rows - 24;
+        if (shown < 1) shown = 1;
+        if (shown > n) shown = n;
+        int table_h = shown + 4;
+        draw_box_ascii(table_y, table_x, table_h, table_w, "Processes");
+        mvprintw(table_y + 1, table_x + 1, "PID | Arrival | Burst | Priority");
+        for (int i = 0; i < shown; ++i) {
+            mvprintw(table_y + 2 + i, table_x + 1, " %2d | %6lld | %5lld | %7d",
+                     processes[i].pid, processes[i].arrival_time, processes[i].burst_time, processes[i].priority);
+        }
+        if (shown < n) mvprintw(table_y + table_h - 2, table_x + 1, " ... %d more", n - shown);
+
+        // Algorithm info
+        int algo_y = table_y + table_h + 1;
+        mvprintw(algo_y, table_x, "Algorithm: [%s]", algorithm_name);
+        if (quantum > 0) {
+            printw("  Quantum: [%d]", quantum);
+        }
+        printw("  Events: [%d]", tlen);
+
+        // Gantt chart
+        int gantt_y = algo_y + 2;
+        int gantt_w = cols - 4;
+        if (gantt_w - 2 > cells_cap) gantt_w = cells_cap + 2;   // realloc failed: draw what fits
+        if (gantt_w >= 3) draw_gantt(gantt_y, table_x, gantt_w, &index, t0, t1, cells);
+
+        // Metrics
+        int metrics_y = gantt_y + 7;
+        draw_box_ascii(metrics_y, table_x, 7, 40, "Metrics");
+        mvprintw(metrics_y + 1, table_x + 1, "Avg Turnaround: %.2f", metrics->avg_turnaround_time);
+        mvprintw(metrics_y + 2, table_x + 1, "Avg Waiting:    %.2f", metrics->avg_waiting_time);
+        mvprintw(metrics_y + 3, table_x + 1, "Avg Response:   %.2f", metrics->avg_response_time);
+        mvprintw(metrics_y + 4, table_x + 1, "CPU Utilization: %.2f%%", metrics->cpu_utilization);
+        mvprintw(metrics_y + 5, table_x + 1, "Throughput: %.4f", metrics->throughput);
+
+        // Footer
+        mvprintw(rows - 2, table_x, "[+/-] Zoom  [Left/Right] Scroll  [0] Reset  [Q]uit");
+
+        refresh();
+        int ch = getch();
+        sim_time_t span = t1 - t0;
+        sim_time_t mid = t0 + span / 2;
+        if (ch == 'q' || ch == 'Q' || ch == ERR) {
+            break;
+        } else if (ch == '+' || ch == '=' || ch == 'i') {
+            span = span / 2 > min_span ? span / 2 : min_span;
+            t0 = mid - span / 2;
+        } else if (ch == '-' || ch == 'o') {
+            span = span * 2;
+            t0 = mid - span / 2;
+        } else if (ch == KEY_LEFT || ch == 'h') {
+            t0 -= span / 4 > 0 ? span / 4 : 1;
+        } else if (ch == KEY_RIGHT || ch == 'l') {
+            t0 += span / 4 > 0 ? span / 4 : 1;
+        } else if (ch == '0' || ch == 'r' || ch == KEY_HOME) {
+            t0 = full_t0;
+            span = full_t1 - full_t0;
+        }
+        // keep the view inside the timeline
+        if (span > full_t1 - full_t0) span = full_t1 - full_t0;
+        if (t0 + span > full_t1) t0 = full_t1 - span;
+        if (t0 < full_t0) t0 = full_t0;
+        t1 = t0 + span;
+    }
+    endwin();
+    free(cells);
+    gantt_index_free(&index);
+}
+
@@ -1,48 +1,254 @@
-/*
- * metrics.c
- *
- * Implements calculate_metrics which computes average turnaround, waiting,
- * response time, CPU utilization, throughput, and Jain's fairness index.
- */
-
-#include <stdio.h>
-#include <math.h>
-#include "metrics.h"
-
-void calculate_metrics(process_t *processes, int n, int total_time, metrics_t *metrics) {
-    double sum_tat = 0.0, sum_wt = 0.0, sum_rt = 0.0;
-    double busy = 0.0;
-    int completed = 0;
-    double sum_x = 0.0, sum_x2 = 0.0;
-    for (int i = 0; i < n; ++i) {
-        process_t *p = &processes[i];
-        if (p->completion_time >= 0) {
-            completed++;
-            p->turnaround_time = p->completion_time - p->arrival_time;
-            p->waiting_time = p->turnaround_time - p->burst_time;
-            if (p->start_time >= 0) p->response_time = p->start_time - p->arrival_time;
-            else p->response_time = -1;
-            sum_tat += p->turnaround_time;
-            sum_wt += p->waiting_time;
-            sum_rt += (p->response_time >=0 ? p->response_time : 0);
-            busy += p->burst_time;
-            sum_x += p->turnaround_time;
-            sum_x2 += (p->turnaround_time * p->turnaround_time);
-        } else {
-            // If not completed, still count partial busy time
-            busy += (p->burst_time - p->remaining_time);
-            // For fairness we skip incomplete processes (but usually tests will complete all)
-        }
-    }
-    metrics->avg_turnaround_time = (completed>0) ? (sum_tat / completed) : 0.0;
-    metrics->avg_waiting_time = (completed>0) ? (sum_wt / completed) : 0.0;
-    metrics->avg_response_time = (completed>0) ? (sum_rt / completed) : 0.0;
-    metrics->cpu_utilization = (total_time>0) ? (busy / total_time * 100.0) : 0.0;
-    metrics->throughput = (total_time>0) ? ((double)completed / (double)total_time) : 0.0;
-    if (n>0 && sum_x2 > 0.0) {
-        metrics->fairness_index = (sum_x * sum_x) / ( (double)n * sum_x2 );
-    } else {
-        metrics->fairness_index = 0.0;
-    }
-}
-
+/*
+ * metrics.c
+ *
+ * Implements calculate_metrics which computes average turnaround, waiting,
+ * response time, CPU utilization, throughput, Jain's fairness index and the
+ * p50/p90/p99/p99.9/max tail of each latency.
+ *
+ * Each latency series is gathered into one contiguous scratch array, reduced
+ * with branch-free loops split over independent lanes (so the compiler can
+ * keep them in vector registers), and its percentiles are found by
+ * quickselect on that array instead of a full sort.
+ *
+ * metrics_acc_* is the incremental alternative: the same metrics from running
+ * sums and log-bucketed histograms, updated as processes complete.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "metrics.h"
+
+#define LANES 4
+
+/* sum and max of x[0..n) */
+static void series_sum_max(const sim_time_t *x, int n, sim_time_t *sum, sim_time_t *max) {
+    sim_time_t s[LANES] = {0}, m[LANES];
+    for (int l = 0; l < LANES; ++l) m[l] = (n > 0) ? x[0] : 0;
+    int i = 0;
+    for (; i + LANES <= n; i += LANES)
+        for (int l = 0; l < LANES; ++l) {
+            s[l] += x[i + l];
+            m[l] = (x[i + l] > m[l]) ? x[i + l] : m[l];
+        }
+    for (; i < n; ++i) {
+        s[0] += x[i];
+        m[0] = (x[i] > m[0]) ? x[i] : m[0];
+    }
+    *sum = s[0] + s[1] + s[2] + s[3];
+    *max = m[0];
+    for (int l = 1; l < LANES; ++l) if (m[l] > *max) *max = m[l];
+}
+
+static double series_sum_squares(const sim_time_t *x, int n) {
+    double s[LANES] = {0};
+    int i = 0;
+    for (; i + LANES <= n; i += LANES)
+        for (int l = 0; l < LANES; ++l) s[l] += (double)x[i + l] * (double)x[i + l];
+    for (; i < n; ++i) s[0] += (double)x[i] * (double)x[i];
+    return (s[0] + s[1]) + (s[2] + s[3]);
+}
+
+/* Rearranges a[0..n) so that a[k] holds the k-th smallest, nothing larger before it and nothing smaller after. */
+static sim_time_t select_kth(sim_time_t *a, int n, int k) {
+    int lo = 0, hi = n - 1;
+    while (hi > lo) {
+        // median of three as pivot, so sorted and reversed input stay linear
+        int mid = lo + (hi - lo) / 2;
+        sim_time_t t;
+        if (a[mid] < a[lo]) { t = a[mid]; a[mid] = a[lo]; a[lo] = t; }
+        if (a[hi] < a[lo]) { t = a[hi]; a[hi] = a[lo]; a[lo] = t; }
+        if (a[hi] < a[mid]) { t = a[hi]; a[hi] = a[mid]; a[mid] = t; }
+        sim_time_t pivot = a[mid];
+        int i = lo, j = hi;
+        while (i <= j) {
+            while (a[i] < pivot) i++;
+            while (a[j] > pivot) j--;
+            if (i <= j) { t = a[i]; a[i] = a[j]; a[j] = t; i++; j--; }
+        }
+        // a[lo..j] <= pivot <= a[i..hi], anything strictly between equals pivot
+        if (k <= j) hi = j;
+        else if (k >= i) lo = i;
+        else break;
+    }
+    return a[k];
+}
+
+/* Nearest-rank index of the per_mille-th percentile among n values */
+static int rank_index(int per_mille, int n) {
+    long long r = ((long long)per_mille * n + 999) / 1000;
+    return (r < 1) ? 0 : (int)(r - 1);
+}
+
+/* Percentiles from the lowest up: everything past a selected rank is no smaller than it,
+   so each selection only searches the suffix left by the previous one (n + n/2 + n/10 + n/100). */
+static void series_tail(sim_time_t *x, int n, sim_time_t max, latency_tail_t *tail) {
+    memset(tail, 0, sizeof(*tail));
+    if (n == 0) return;
+    static const int per_mille[4] = {500, 900, 990, 999};
+    double *out[4] = { &tail->p50, &tail->p90, &tail->p99, &tail->p999 };
+    int from = 0;
+    for (int i = 0; i < 4; ++i) {
+        int k = rank_index(per_mille[i], n);
+        *out[i] = (double)select_kth(x + from, n - from, k - from);
+        from = k;
+    }
+    tail->max = (double)max;
+}
+
+void calculate_metrics(process_store_t *ps, sim_time_t total_time, metrics_t *metrics) {
+    int n = ps->n;
+    const process_hot_t *hot = ps->hot;
+    process_cold_t *cold = ps->cold;
+    memset(metrics, 0, sizeof(*metrics));
+
+    // one contiguous series per latency, holding the completed processes only
+    size_t slots = n > 0 ? (size_t)n : 1;
+    sim_time_t *tat = malloc(sizeof(sim_time_t) * slots);
+    sim_time_t *wt = malloc(sizeof(sim_time_t) * slots);
+    sim_time_t *rt = malloc(sizeof(sim_time_t) * slots);
+    if (!tat || !wt || !rt) { perror("malloc"); free(tat); free(wt); free(rt); return; }
+
+    // single pass over the store: every process adds the CPU time it got to busy; unfinished ones
+    // are skipped after that, and completed ones get their times filled in and appended to the series
+    // (response 0 if one somehow completed without a recorded start).
+    int completed = 0;
+    sim_time_t busy = 0;
+    for (int i = 0; i < n; ++i) {
+        const process_hot_t *h = &hot[i];
+        process_cold_t *c = &cold[i];
+        busy += h->burst_time - h->remaining_time;
+        if (c->completion_time < 0) continue;
+        c->turnaround_time = c->completion_time - h->arrival_time;
+        c->waiting_time = c->turnaround_time - h->burst_time;
+        c->response_time = (c->start_time >= 0) ? c->start_time - h->arrival_time : -1;
+        tat[completed] = c->turnaround_time;
+        wt[completed] = c->waiting_time;
+        rt[completed] = (c->response_time >= 0) ? c->response_time : 0;
+        completed++;
+    }
+    metrics->cpu_utilization = (total_time>0) ? ((double)busy / total_time * 100.0) : 0.0;
+    metrics->throughput = (total_time>0) ? ((double)completed / (double)total_time) : 0.0;
+
+    if (completed > 0) {
+        sim_time_t sum, max;
+        series_sum_max(tat, completed, &sum, &max);
+        metrics->avg_turnaround_time = (double)sum / completed;
+        double sum_x2 = series_sum_squares(tat, completed);
+        if (sum_x2 > 0.0)
+            metrics->fairness_index = ((double)sum * (double)sum) / ( (double)n * sum_x2 );
+        series_tail(tat, completed, max, &metrics->turnaround);
+
+        series_sum_max(wt, completed, &sum, &max);
+        metrics->avg_waiting_time = (double)sum / completed;
+        series_tail(wt, completed, max, &metrics->waiting);
+
+        series_sum_max(rt, completed, &sum, &max);
+        metrics->avg_response_time = (double)sum / completed;
+        series_tail(rt, completed, max, &metrics->response);
+    }
+    free(tat);
+    free(wt);
+    free(rt);
+}
+
+/* ---- incremental accumulator ---- */
+
+#define SUB_COUNT (1 << LATENCY_HIST_SUB_BITS)
+
+static int hist_index(sim_time_t v) {
+    if (v < SUB_COUNT) return (int)(v < 0 ? 0 : v);
+    int msb = 63 - __builtin_clzll((unsigned long long)v);
+    int shift = msb - LATENCY_HIST_SUB_BITS;
+    return ((shift + 1) << LATENCY_HIST_SUB_BITS) + (int)((v >> shift) - SUB_COUNT);
+}
+
+/* largest value that lands in bucket idx */
+static sim_time_t hist_highest(int idx) {
+    if (idx < SUB_COUNT) return idx;
+    int shift = (idx >> LATENCY_HIST_SUB_BITS) - 1;
+    sim_time_t lo = (sim_time_t)(SUB_COUNT + (idx & (SUB_COUNT - 1))) << shift;
+    return lo + (((sim_time_t)1 << shift) - 1);
+}
+
+static void hist_record(latency_hist_t *h, sim_time_t v) {
+    h->counts[hist_index(v)]++;
+    h->total++;
+    if (v > h->max) h->max = v;
+}
+
+/* One walk over the buckets for all four ranks; values are clamped to the recorded max. */
+static void hist_tail(const latency_hist_t *h, latency_tail_t *tail) {
+    memset(tail, 0, sizeof(*tail));
+    if (h->total == 0) return;
+    static const int per_mille[4] = {500, 900, 990, 999};
+    double *out[4] = { &tail->p50, &tail->p90, &tail->p99, &tail->p999 };
+    long long seen = 0;
+    int next = 0;
+    for (int i = 0; i < LATENCY_HIST_BUCKETS && next < 4; ++i) {
+        seen += h->counts[i];
+        while (next < 4) {
+            long long rank = ((long long)per_mille[next] * h->total + 999) / 1000;
+            if (rank < 1) rank = 1;
+            if (seen < rank) break;
+            sim_time_t v = hist_highest(i);
+            *out[next++] = (double)(v < h->max ? v : h->max);
+        }
+    }
+    tail->max = (double)h->max;
+}
+
+int metrics_acc_init(metrics_acc_t *acc) {
+    memset(acc, 0, sizeof(*acc));
+    long long *counts = calloc(3 * (size_t)LATENCY_HIST_BUCKETS, sizeof(long long));
+    if (!counts) { perror("calloc"); return -1; }
+    acc->turnaround.counts = counts;
+    acc->waiting.counts = counts + LATENCY_HIST_BUCKETS;
+    acc->response.counts = counts + 2 * LATENCY_HIST_BUCKETS;
+    return 0;
+}
+
+void metrics_acc_reset(metrics_acc_t *acc) {
+    long long *counts = acc->turnaround.counts;
+    memset(counts, 0, 3 * (size_t)LATENCY_HIST_BUCKETS * sizeof(long long));
+    memset(acc, 0, sizeof(*acc));
+    acc->turnaround.counts = counts;
+    acc->waiting.counts = counts + LATENCY_HIST_BUCKETS;
+    acc->response.counts = counts + 2 * LATENCY_HIST_BUCKETS;
+}
+
+void metrics_acc_free(metrics_acc_t *acc) {
+    free(acc->turnaround.counts);
+    memset(acc, 0, sizeof(*acc));
+}
+
+void metrics_acc_record(metrics_acc_t *acc, sim_time_t turnaround, sim_time_t waiting,
+                        sim_time_t response, sim_time_t burst) {
+    if (response < 0) response = 0;     // never started counts as 0, as in calculate_metrics
+    acc->completed++;
+    acc->busy += burst;
+    acc->sum_turnaround += turnaround;
+    acc->sum_waiting += waiting;
+    acc->sum_response += response;
+    acc->sum_turnaround_sq += (double)turnaround * (double)turnaround;
+    hist_record(&acc->turnaround, turnaround);
+    hist_record(&acc->waiting, waiting);
+    hist_record(&acc->response, response);
+}
+
+void metrics_acc_snapshot(const metrics_acc_t *acc, sim_time_t total_time, metrics_t *metrics) {
+    memset(metrics, 0, sizeof(*metrics));
+    long long n = acc->completed;
+    metrics->cpu_utilization = (total_time>0) ? ((double)acc->busy / total_time * 100.0) : 0.0;
+    metrics->throughput = (total_time>0) ? ((double)n / (double)total_time) : 0.0;
+    if (n == 0) return;
+    metrics->avg_turnaround_time = (double)acc->sum_turnaround / n;
+    metrics->avg_waiting_time = (double)acc->sum_waiting / n;
+    metrics->avg_response_time = (double)acc->sum_response / n;
+    if (acc->sum_turnaround_sq > 0.0)
+        metrics->fairness_index = ((double)acc->sum_turnaround * (double)acc->sum_turnaround) /
+                                  ((double)n * acc->sum_turnaround_sq);
+    hist_tail(&acc->turnaround, &metrics->turnaround);
+    hist_tail(&acc->waiting, &metrics->waiting);
+    hist_tail(&acc->response, &metrics->response);
+}
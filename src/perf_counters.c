@@ -0,0 +1,103 @@
+/*
+ * perf_counters.c
+ *
+ * Thin wrapper over perf_event_open. Each counter is opened on its own (not as
+ * a group), so one the CPU lacks does not take the others down with it.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "perf_counters.h"
+
+static const char *names[PERF_NUM_COUNTERS] = {
+    "cycles", "instructions", "l1d_misses", "llc_misses", "branch_misses"
+};
+
+const char *perf_counter_name(perf_counter_id_t id) {
+    return (id >= 0 && id < PERF_NUM_COUNTERS) ? names[id] : "?";
+}
+
+#ifdef __linux__
+
+#include <stdint.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+
+static int open_counter(uint32_t type, uint64_t config) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+int perf_counters_open(perf_counters_t *pc) {
+    const uint64_t l1d_read_miss = PERF_COUNT_HW_CACHE_L1D |
+                                   (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                                   (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    pc->fd[PERF_CYCLES] = open_counter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+    pc->fd[PERF_INSTRUCTIONS] = open_counter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+    pc->fd[PERF_L1D_MISSES] = open_counter(PERF_TYPE_HW_CACHE, l1d_read_miss);
+    pc->fd[PERF_LLC_MISSES] = open_counter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+    pc->fd[PERF_BRANCH_MISSES] = open_counter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+    pc->available = 0;
+    for (int i = 0; i < PERF_NUM_COUNTERS; ++i) {
+        if (pc->fd[i] < 0) pc->fd[i] = -1;
+        else pc->available++;
+    }
+    return pc->available;
+}
+
+void perf_counters_start(perf_counters_t *pc) {
+    for (int i = 0; i < PERF_NUM_COUNTERS; ++i) {
+        if (pc->fd[i] < 0) continue;
+        ioctl(pc->fd[i], PERF_EVENT_IOC_RESET, 0);
+        ioctl(pc->fd[i], PERF_EVENT_IOC_ENABLE, 0);
+    }
+}
+
+void perf_counters_stop(perf_counters_t *pc, double *values) {
+    for (int i = 0; i < PERF_NUM_COUNTERS; ++i)
+        if (pc->fd[i] >= 0) ioctl(pc->fd[i], PERF_EVENT_IOC_DISABLE, 0);
+    for (int i = 0; i < PERF_NUM_COUNTERS; ++i) {
+        uint64_t buf[3];    // value, time enabled, time running
+        values[i] = -1;
+        if (pc->fd[i] < 0 || read(pc->fd[i], buf, sizeof(buf)) != (ssize_t)sizeof(buf)) continue;
+        if (buf[2] == 0) continue;  // never got on the PMU
+        values[i] = (double)buf[0] * ((double)buf[1] / (double)buf[2]);
+    }
+}
+
+void perf_counters_close(perf_counters_t *pc) {
+    for (int i = 0; i < PERF_NUM_COUNTERS; ++i) {
+        if (pc->fd[i] >= 0) close(pc->fd[i]);
+        pc->fd[i] = -1;
+    }
+    pc->available = 0;
+}
+
+#else
+
+int perf_counters_open(perf_counters_t *pc) {
+    for (int i = 0; i < PERF_NUM_COUNTERS; ++i) pc->fd[i] = -1;
+    pc->available = 0;
+    return 0;
+}
+
+void perf_counters_start(perf_counters_t *pc) { (void)pc; }
+
+void perf_counters_stop(perf_counters_t *pc, double *values) {
+    (void)pc;
+    for (int i = 0; i < PERF_NUM_COUNTERS; ++i) values[i] = -1;
+}
+
+void perf_counters_close(perf_counters_t *pc) { (void)pc; }
+
+#endif
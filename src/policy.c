@@ -0,0 +1,139 @@
+/*
+ * policy.c
+ *
+ * Policy registry: maps command-line names to the engine callbacks in
+ * algorithms.c, parses their parameters and holds the report configuration.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "policy.h"
+
+#define REPORT_QUANTUM 3
+#define REPORT_PRIO_AGING 50
+
+static int report_mlfq_quantums[3] = {4, 8, 16};
+
+int policy_parse_mlfq(char **args, mlfq_config_t *cfg) {
+    int numq = atoi(args[0]);
+    char *csv = args[1];
+    int boost = atoi(args[2]);
+    if (numq <= 0) { fprintf(stderr, "num_queues must be > 0\n"); return 3; }
+    int *quantums = malloc(sizeof(int)*numq);
+    char *tmp = strdup(csv);
+    char *tok = strtok(tmp, ",");
+    int i = 0;
+    while (tok && i < numq) {
+        quantums[i++] = atoi(tok);
+        tok = strtok(NULL, ",");
+    }
+    free(tmp);
+    if (i != numq) { fprintf(stderr, "quantums count mismatch\n"); free(quantums); return 4; }
+    for (int q = 0; q < numq; ++q)
+        if (quantums[q] <= 0) { fprintf(stderr, "quantum must be > 0\n"); free(quantums); return 3; }
+    if (boost < 0) { fprintf(stderr, "boost interval must be >= 0\n"); free(quantums); return 3; }
+    cfg->num_queues = numq;
+    cfg->quantums = quantums;
+    cfg->boost_interval = boost;
+    return 0;
+}
+
+static int parse_none(int argc, char **argv, policy_params_t *params) {
+    (void)argc; (void)argv; (void)params;
+    return 0;
+}
+
+static int parse_quantum(const char *name, int argc, char **argv, policy_params_t *params) {
+    if (argc < 1) { fprintf(stderr, "%s requires quantum param\n", name); return 3; }
+    params->quantum = atoi(argv[0]);
+    if (params->quantum <= 0) { fprintf(stderr, "quantum must be > 0\n"); return 3; }
+    return 0;
+}
+
+static int parse_rr(int argc, char **argv, policy_params_t *params) {
+    return parse_quantum("rr", argc, argv, params);
+}
+
+static int parse_mlfq(int argc, char **argv, policy_params_t *params) {
+    if (argc < 3) { fprintf(stderr, "mlfq requires num_queues quantums_csv boost_interval\n"); return 3; }
+    return policy_parse_mlfq(argv, &params->mlfq);
+}
+
+static int parse_priority(int argc, char **argv, policy_params_t *params, int preemptive) {
+    params->prio.preemptive = preemptive;
+    params->prio.aging_interval = (argc >= 1) ? atoi(argv[0]) : 0;
+    if (params->prio.aging_interval < 0) { fprintf(stderr, "aging interval must be >= 0\n"); return 3; }
+    return 0;
+}
+
+static int parse_prio(int argc, char **argv, policy_params_t *params) {
+    return parse_priority(argc, argv, params, 0);
+}
+
+static int parse_pprio(int argc, char **argv, policy_params_t *params) {
+    return parse_priority(argc, argv, params, 1);
+}
+
+static int parse_lottery(int argc, char **argv, policy_params_t *params) {
+    int rc = parse_quantum("lottery", argc, argv, params);
+    params->seed = (argc >= 2) ? strtoull(argv[1], NULL, 10) : LOTTERY_DEFAULT_SEED;
+    return rc;
+}
+
+static int parse_stride(int argc, char **argv, policy_params_t *params) {
+    return parse_quantum("stride", argc, argv, params);
+}
+
+static int parse_cfs(int argc, char **argv, policy_params_t *params) {
+    params->cfs.target_latency = (argc >= 1) ? atoi(argv[0]) : CFS_DEFAULT_LATENCY;
+    params->cfs.min_granularity = (argc >= 2) ? atoi(argv[1]) : CFS_DEFAULT_GRANULARITY;
+    if (params->cfs.target_latency <= 0 || params->cfs.min_granularity <= 0) {
+        fprintf(stderr, "target latency and granularity must be > 0\n");
+        return 3;
+    }
+    return 0;
+}
+
+static const policy_entry_t registry[POLICY_COUNT] = {
+    {"fifo", "FIFO", "", 0, &policy_fifo, parse_none, {0}},
+    {"sjf", "SJF", "", 0, &policy_sjf, parse_none, {0}},
+    {"stcf", "STCF", "", 0, &policy_stcf, parse_none, {0}},
+    {"rr", "RR", "<quantum>", 1, &policy_rr, parse_rr, {.quantum = REPORT_QUANTUM}},
+    {"mlfq", "MLFQ", "<num_q> <comma_quants> <boost_interval>", 3, &policy_mlfq, parse_mlfq,
+     {.mlfq = {3, report_mlfq_quantums, 50}}},
+    {"priority", "PRIO", "[aging_interval]", 1, &policy_priority, parse_prio,
+     {.prio = {0, REPORT_PRIO_AGING}}},
+    {"ppriority", "PPRIO", "[aging_interval]  (preemptive)", 1, &policy_ppriority, parse_pprio,
+     {.prio = {1, REPORT_PRIO_AGING}}},
+    {"lottery", "LOTTERY", "<quantum> [seed]", 2, &policy_lottery, parse_lottery,
+     {.quantum = REPORT_QUANTUM, .seed = LOTTERY_DEFAULT_SEED}},
+    {"stride", "STRIDE", "<quantum>", 1, &policy_stride, parse_stride, {.quantum = REPORT_QUANTUM}},
+    {"cfs", "CFS", "[target_latency] [min_granularity]", 2, &policy_cfs, parse_cfs,
+     {.cfs = {CFS_DEFAULT_LATENCY, CFS_DEFAULT_GRANULARITY}}},
+};
+
+const policy_entry_t *policy_get(int slot) {
+    return &registry[slot];
+}
+
+int policy_find(const char *name) {
+    for (int i = 0; i < POLICY_COUNT; ++i)
+        if (strcmp(name, registry[i].name) == 0) return i;
+    return -1;
+}
+
+int policy_params_equal(const policy_params_t *a, const policy_params_t *b) {
+    if (a->quantum != b->quantum || a->seed != b->seed) return 0;
+    if (a->prio.preemptive != b->prio.preemptive || a->prio.aging_interval != b->prio.aging_interval) return 0;
+    if (a->cfs.target_latency != b->cfs.target_latency || a->cfs.min_granularity != b->cfs.min_granularity) return 0;
+    if (a->mlfq.num_queues != b->mlfq.num_queues || a->mlfq.boost_interval != b->mlfq.boost_interval) return 0;
+    for (int q = 0; q < a->mlfq.num_queues; ++q)
+        if (a->mlfq.quantums[q] != b->mlfq.quantums[q]) return 0;
+    return 1;
+}
+
+void policy_print_usage(FILE *out, const char *indent) {
+    for (int i = 0; i < POLICY_COUNT; ++i)
+        fprintf(out, "%s%s%s%s\n", indent, registry[i].name, registry[i].usage[0] ? " " : "", registry[i].usage);
+}
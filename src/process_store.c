@@ -0,0 +1,99 @@
+/*
+ * process_store.c
+ *
+ * Hot/cold process store used by the scheduling engines, and conversion
+ * to and from the process_t records used for loading and output.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "process_store.h"
+#include "metrics.h"
+
+int process_store_reserve(process_store_t *ps, int capacity) {
+    if (capacity <= ps->capacity) return 0;
+    process_hot_t *hot = realloc(ps->hot, sizeof(process_hot_t) * capacity);
+    if (!hot) return -1;
+    ps->hot = hot;
+    process_cold_t *cold = realloc(ps->cold, sizeof(process_cold_t) * capacity);
+    if (!cold) return -1;
+    ps->cold = cold;
+    ps->capacity = capacity;
+    return 0;
+}
+
+int process_store_init(process_store_t *ps, const process_t *processes, int n) {
+    ps->hot = NULL;
+    ps->cold = NULL;
+    ps->n = 0;
+    ps->capacity = 0;
+    ps->acc = NULL;
+    ps->stats = NULL;
+    if (process_store_reserve(ps, n > 0 ? n : 1) != 0) {
+        perror("malloc");
+        process_store_free(ps);
+        return -1;
+    }
+    for (int i = 0; i < n; ++i) {
+        ps->hot[i].pid = processes[i].pid;
+        ps->hot[i].arrival_time = processes[i].arrival_time;
+        ps->hot[i].burst_time = processes[i].burst_time;
+        ps->hot[i].priority = processes[i].priority;
+    }
+    ps->n = n;
+    process_store_reset(ps);
+    return 0;
+}
+
+void process_store_reset_one(process_store_t *ps, int idx) {
+    process_cold_t *c = &ps->cold[idx];
+    ps->hot[idx].remaining_time = ps->hot[idx].burst_time;
+    c->start_time = -1;
+    c->completion_time = -1;
+    c->turnaround_time = 0;
+    c->waiting_time = 0;
+    c->response_time = -1;
+    c->finished = 0;
+}
+
+void process_store_reset(process_store_t *ps) {
+    for (int i = 0; i < ps->n; ++i) process_store_reset_one(ps, i);
+    if (ps->acc) metrics_acc_reset(ps->acc);
+    if (ps->stats) memset(ps->stats, 0, sizeof(*ps->stats));
+}
+
+void process_store_complete(process_store_t *ps, int idx, sim_time_t time) {
+    process_hot_t *h = &ps->hot[idx];
+    process_cold_t *c = &ps->cold[idx];
+    h->remaining_time = 0;
+    c->completion_time = time;
+    c->finished = 1;
+    c->turnaround_time = time - h->arrival_time;
+    c->waiting_time = c->turnaround_time - h->burst_time;
+    c->response_time = c->start_time - h->arrival_time;
+    if (ps->acc) metrics_acc_record(ps->acc, c->turnaround_time, c->waiting_time, c->response_time, h->burst_time);
+}
+
+void process_store_free(process_store_t *ps) {
+    free(ps->hot);
+    free(ps->cold);
+    ps->hot = NULL;
+    ps->cold = NULL;
+    ps->n = ps->capacity = 0;
+}
+
+void process_store_export(const process_store_t *ps, process_t *processes) {
+    for (int i = 0; i < ps->n; ++i) {
+        const process_hot_t *h = &ps->hot[i];
+        const process_cold_t *c = &ps->cold[i];
+        process_t *p = &processes[i];
+        p->remaining_time = h->remaining_time;
+        p->start_time = c->start_time;
+        p->completion_time = c->completion_time;
+        p->turnaround_time = c->turnaround_time;
+        p->waiting_time = c->waiting_time;
+        p->response_time = c->response_time;
+        p->finished = c->finished;
+    }
+}
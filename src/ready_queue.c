@@ -0,0 +1,451 @@
+/*
+ * ready_queue.c
+ *
+ * Indexed min-heap used as the ready queue of the shortest-first and stride
+ * policies, the bucket queue and ticket tree of the priority and lottery
+ * policies, the red-black tree of the CFS policy, plus the arrival-sorted
+ * cursor that feeds them.
+ */
+
+#include <stdlib.h>
+#include "ready_queue.h"
+
+int rq_init(ready_queue_t *rq, process_hot_t *hot, int n, rq_cmp_fn cmp) {
+    rq->heap = malloc(sizeof(int) * (n > 0 ? n : 1));
+    rq->pos = malloc(sizeof(int) * (n > 0 ? n : 1));
+    if (!rq->heap || !rq->pos) {
+        free(rq->heap); free(rq->pos);
+        rq->heap = rq->pos = NULL;
+        return -1;
+    }
+    for (int i = 0; i < n; ++i) rq->pos[i] = -1;
+    rq->size = 0;
+    rq->capacity = n;
+    rq->hot = hot;
+    rq->cmp = cmp;
+    rq->key = NULL;
+    rq->comparisons = 0;
+    return 0;
+}
+
+int rq_init_keyed(ready_queue_t *rq, process_hot_t *hot, int n, const long long *key) {
+    if (rq_init(rq, hot, n, NULL) != 0) return -1;
+    rq->key = key;
+    return 0;
+}
+
+int rq_reserve(ready_queue_t *rq, process_hot_t *hot, int capacity) {
+    rq->hot = hot;
+    if (capacity <= rq->capacity) return 0;
+    int *heap = realloc(rq->heap, sizeof(int) * capacity);
+    if (!heap) return -1;
+    rq->heap = heap;
+    int *pos = realloc(rq->pos, sizeof(int) * capacity);
+    if (!pos) return -1;
+    rq->pos = pos;
+    for (int i = rq->capacity; i < capacity; ++i) rq->pos[i] = -1;
+    rq->capacity = capacity;
+    return 0;
+}
+
+void rq_free(ready_queue_t *rq) {
+    free(rq->heap);
+    free(rq->pos);
+    rq->heap = rq->pos = NULL;
+    rq->size = rq->capacity = 0;
+}
+
+static int less(ready_queue_t *rq, int a, int b) {
+#ifdef SCHED_STATS
+    rq->comparisons++;
+#endif
+    int x = rq->heap[a], y = rq->heap[b];
+    if (rq->key) return rq->key[x] < rq->key[y] || (rq->key[x] == rq->key[y] && x < y);
+    return rq->cmp(&rq->hot[x], &rq->hot[y]) < 0;
+}
+
+static void swap_slots(ready_queue_t *rq, int a, int b) {
+    int t = rq->heap[a]; rq->heap[a] = rq->heap[b]; rq->heap[b] = t;
+    rq->pos[rq->heap[a]] = a;
+    rq->pos[rq->heap[b]] = b;
+}
+
+static void sift_up(ready_queue_t *rq, int i) {
+    while (i > 0) {
+        int parent = (i - 1) / 2;
+        if (!less(rq, i, parent)) break;
+        swap_slots(rq, i, parent);
+        i = parent;
+    }
+}
+
+static void sift_down(ready_queue_t *rq, int i) {
+    for (;;) {
+        int l = 2 * i + 1, r = l + 1, m = i;
+        if (l < rq->size && less(rq, l, m)) m = l;
+        if (r < rq->size && less(rq, r, m)) m = r;
+        if (m == i) break;
+        swap_slots(rq, i, m);
+        i = m;
+    }
+}
+
+void rq_push(ready_queue_t *rq, int idx) {
+    if (rq->pos[idx] >= 0) return;   // already queued
+    int slot = rq->size++;
+    rq->heap[slot] = idx;
+    rq->pos[idx] = slot;
+    sift_up(rq, slot);
+}
+
+int rq_peek(const ready_queue_t *rq) {
+    return rq->size > 0 ? rq->heap[0] : -1;
+}
+
+int rq_pop(ready_queue_t *rq) {
+    if (rq->size == 0) return -1;
+    int top = rq->heap[0];
+    rq_remove(rq, top);
+    return top;
+}
+
+void rq_update(ready_queue_t *rq, int idx) {
+    int slot = rq->pos[idx];
+    if (slot < 0) return;
+    sift_up(rq, slot);
+    sift_down(rq, rq->pos[idx]);
+}
+
+void rq_remove(ready_queue_t *rq, int idx) {
+    int slot = rq->pos[idx];
+    if (slot < 0) return;
+    int last = --rq->size;
+    rq->pos[idx] = -1;
+    if (slot != last) {
+        int moved = rq->heap[last];
+        rq->heap[slot] = moved;
+        rq->pos[moved] = slot;
+        sift_up(rq, slot);
+        sift_down(rq, rq->pos[moved]);
+    }
+}
+
+int pq_init(prio_queue_t *pq, int n) {
+    pq->link = malloc(sizeof(int) * (n > 0 ? n : 1));
+    if (!pq->link) return -1;
+    for (int b = 0; b < PRIO_BUCKETS; ++b) ilist_init(&pq->bucket[b]);
+    pq->bitmap = 0;
+    return 0;
+}
+
+void pq_free(prio_queue_t *pq) {
+    free(pq->link);
+    pq->link = NULL;
+}
+
+void pq_age(prio_queue_t *pq, int k) {
+    if (k <= 0 || pq->bitmap == 0) return;
+    if (k >= PRIO_BUCKETS) k = PRIO_BUCKETS - 1;
+    // ascending order: each target bucket has already handed its own entries down
+    for (int b = 1; b < PRIO_BUCKETS; ++b) {
+        if (!(pq->bitmap & (1ULL << b))) continue;
+        int to = b > k ? b - k : 0;
+        ilist_splice(&pq->bucket[to], &pq->bucket[b], pq->link);
+    }
+    uint64_t low = (2ULL << k) - 1;   // buckets 0..k all land in 0
+    pq->bitmap = (pq->bitmap >> k) | ((pq->bitmap & low) ? 1 : 0);
+}
+
+int tt_init(ticket_tree_t *tt, int n) {
+    tt->tree = calloc((size_t)n + 1, sizeof(long long));
+    if (!tt->tree) return -1;
+    tt->n = n;
+    tt->top = 1;
+    while (tt->top * 2 <= n) tt->top *= 2;
+    tt->total = 0;
+    return 0;
+}
+
+void tt_free(ticket_tree_t *tt) {
+    free(tt->tree);
+    tt->tree = NULL;
+}
+
+void tt_add(ticket_tree_t *tt, int idx, long long delta) {
+    tt->total += delta;
+    for (int i = idx + 1; i <= tt->n; i += i & -i) tt->tree[i] += delta;
+}
+
+int tt_find(const ticket_tree_t *tt, long long r) {
+    // descend from the top power of two: pos ends as the last index whose prefix sum is <= r
+    int pos = 0;
+    for (int step = tt->top; step > 0; step >>= 1) {
+        if (pos + step <= tt->n && tt->tree[pos + step] <= r) {
+            pos += step;
+            r -= tt->tree[pos];
+        }
+    }
+    return pos;     // 0-based index of the next process
+}
+
+long long tt_get(const ticket_tree_t *tt, int idx) {
+    // node idx+1 covers (idx+1 - lowbit, idx+1]; peel off everything below idx
+    int i = idx + 1;
+    long long v = tt->tree[i];
+    for (int j = idx, stop = i - (i & -i); j > stop; j -= j & -j) v -= tt->tree[j];
+    return v;
+}
+
+int rbt_init(rb_tree_t *t, int n, const long long *key) {
+    size_t slots = (size_t)n + 1;
+    t->left = malloc(sizeof(int) * slots);
+    t->right = malloc(sizeof(int) * slots);
+    t->parent = malloc(sizeof(int) * slots);
+    t->red = malloc(slots);
+    if (!t->left || !t->right || !t->parent || !t->red) {
+        rbt_free(t);
+        return -1;
+    }
+    t->key = key;
+    t->nil = n;
+    t->left[n] = t->right[n] = t->parent[n] = n;
+    t->red[n] = 0;
+    t->root = t->first = n;
+    t->size = 0;
+    t->comparisons = 0;
+    return 0;
+}
+
+void rbt_free(rb_tree_t *t) {
+    free(t->left); free(t->right); free(t->parent); free(t->red);
+    t->left = t->right = t->parent = NULL;
+    t->red = NULL;
+    t->size = 0;
+}
+
+static int rb_before(rb_tree_t *t, int a, int b) {
+#ifdef SCHED_STATS
+    t->comparisons++;
+#endif
+    return t->key[a] < t->key[b] || (t->key[a] == t->key[b] && a < b);
+}
+
+static void rb_rotate_left(rb_tree_t *t, int x) {
+    int y = t->right[x];
+    t->right[x] = t->left[y];
+    if (t->left[y] != t->nil) t->parent[t->left[y]] = x;
+    t->parent[y] = t->parent[x];
+    if (t->parent[x] == t->nil) t->root = y;
+    else if (x == t->left[t->parent[x]]) t->left[t->parent[x]] = y;
+    else t->right[t->parent[x]] = y;
+    t->left[y] = x;
+    t->parent[x] = y;
+}
+
+static void rb_rotate_right(rb_tree_t *t, int x) {
+    int y = t->left[x];
+    t->left[x] = t->right[y];
+    if (t->right[y] != t->nil) t->parent[t->right[y]] = x;
+    t->parent[y] = t->parent[x];
+    if (t->parent[x] == t->nil) t->root = y;
+    else if (x == t->right[t->parent[x]]) t->right[t->parent[x]] = y;
+    else t->left[t->parent[x]] = y;
+    t->right[y] = x;
+    t->parent[x] = y;
+}
+
+void rbt_insert(rb_tree_t *t, int z) {
+    int y = t->nil, x = t->root;
+    int leftmost = 1;
+    while (x != t->nil) {
+        y = x;
+        if (rb_before(t, z, x)) x = t->left[x];
+        else { x = t->right[x]; leftmost = 0; }
+    }
+    t->parent[z] = y;
+    if (y == t->nil) t->root = z;
+    else if (rb_before(t, z, y)) t->left[y] = z;
+    else t->right[y] = z;
+    t->left[z] = t->right[z] = t->nil;
+    t->red[z] = 1;
+    if (leftmost) t->first = z;
+    t->size++;
+    // restore the red-black properties (CLRS insert fixup)
+    while (t->red[t->parent[z]]) {
+        int p = t->parent[z], g = t->parent[p];
+        if (p == t->left[g]) {
+            int u = t->right[g];
+            if (t->red[u]) {
+                t->red[p] = t->red[u] = 0;
+                t->red[g] = 1;
+                z = g;
+            } else {
+                if (z == t->right[p]) { z = p; rb_rotate_left(t, z); p = t->parent[z]; }
+                t->red[p] = 0;
+                t->red[g] = 1;
+                rb_rotate_right(t, g);
+            }
+        } else {
+            int u = t->left[g];
+            if (t->red[u]) {
+                t->red[p] = t->red[u] = 0;
+                t->red[g] = 1;
+                z = g;
+            } else {
+                if (z == t->left[p]) { z = p; rb_rotate_right(t, z); p = t->parent[z]; }
+                t->red[p] = 0;
+                t->red[g] = 1;
+                rb_rotate_left(t, g);
+            }
+        }
+    }
+    t->red[t->root] = 0;
+}
+
+static void rb_transplant(rb_tree_t *t, int u, int v) {
+    if (t->parent[u] == t->nil) t->root = v;
+    else if (u == t->left[t->parent[u]]) t->left[t->parent[u]] = v;
+    else t->right[t->parent[u]] = v;
+    t->parent[v] = t->parent[u];    // may write the sentinel; the fixup relies on it
+}
+
+static int rb_min(const rb_tree_t *t, int x) {
+    while (t->left[x] != t->nil) x = t->left[x];
+    return x;
+}
+
+void rbt_remove(rb_tree_t *t, int z) {
+    if (z == t->first) {
+        // successor of the leftmost node: min of its right subtree, else its parent
+        t->first = (t->right[z] != t->nil) ? rb_min(t, t->right[z]) : t->parent[z];
+    }
+    int y = z, x;
+    char y_red = t->red[y];
+    if (t->left[z] == t->nil) {
+        x = t->right[z];
+        rb_transplant(t, z, x);
+    } else if (t->right[z] == t->nil) {
+        x = t->left[z];
+        rb_transplant(t, z, x);
+    } else {
+        y = rb_min(t, t->right[z]);
+        y_red = t->red[y];
+        x = t->right[y];
+        if (t->parent[y] == z) {
+            t->parent[x] = y;
+        } else {
+            rb_transplant(t, y, x);
+            t->right[y] = t->right[z];
+            t->parent[t->right[y]] = y;
+        }
+        rb_transplant(t, z, y);
+        t->left[y] = t->left[z];
+        t->parent[t->left[y]] = y;
+        t->red[y] = t->red[z];
+    }
+    t->size--;
+    if (y_red) return;
+    // x carries an extra black (CLRS delete fixup)
+    while (x != t->root && !t->red[x]) {
+        int p = t->parent[x];
+        if (x == t->left[p]) {
+            int w = t->right[p];
+            if (t->red[w]) {
+                t->red[w] = 0; t->red[p] = 1;
+                rb_rotate_left(t, p);
+                w = t->right[p];
+            }
+            if (!t->red[t->left[w]] && !t->red[t->right[w]]) {
+                t->red[w] = 1;
+                x = p;
+            } else {
+                if (!t->red[t->right[w]]) {
+                    t->red[t->left[w]] = 0; t->red[w] = 1;
+                    rb_rotate_right(t, w);
+                    w = t->right[p];
+                }
+                t->red[w] = t->red[p];
+                t->red[p] = 0;
+                t->red[t->right[w]] = 0;
+                rb_rotate_left(t, p);
+                x = t->root;
+            }
+        } else {
+            int w = t->left[p];
+            if (t->red[w]) {
+                t->red[w] = 0; t->red[p] = 1;
+                rb_rotate_right(t, p);
+                w = t->left[p];
+            }
+            if (!t->red[t->right[w]] && !t->red[t->left[w]]) {
+                t->red[w] = 1;
+                x = p;
+            } else {
+                if (!t->red[t->left[w]]) {
+                    t->red[t->right[w]] = 0; t->red[w] = 1;
+                    rb_rotate_left(t, w);
+                    w = t->left[p];
+                }
+                t->red[w] = t->red[p];
+                t->red[p] = 0;
+                t->red[t->left[w]] = 0;
+                rb_rotate_right(t, p);
+                x = t->root;
+            }
+        }
+    }
+    t->red[x] = 0;
+}
+
+int rbt_items(const rb_tree_t *t, int *out) {
+    // in-order walk by successor: right subtree's minimum, else the first ancestor we are left of
+    int count = 0;
+    for (int x = t->size ? t->first : t->nil; x != t->nil; ) {
+        out[count++] = x;
+        if (t->right[x] != t->nil) {
+            x = rb_min(t, t->right[x]);
+        } else {
+            int p = t->parent[x];
+            while (p != t->nil && x == t->right[p]) { x = p; p = t->parent[p]; }
+            x = p;
+        }
+    }
+    return count;
+}
+
+int rq_cmp_burst(const process_hot_t *a, const process_hot_t *b) {
+    if (a->burst_time != b->burst_time) return a->burst_time < b->burst_time ? -1 : 1;
+    if (a->arrival_time != b->arrival_time) return a->arrival_time < b->arrival_time ? -1 : 1;
+    return (a->pid > b->pid) - (a->pid < b->pid);
+}
+
+int rq_cmp_remaining(const process_hot_t *a, const process_hot_t *b) {
+    if (a->remaining_time != b->remaining_time) return a->remaining_time < b->remaining_time ? -1 : 1;
+    if (a->arrival_time != b->arrival_time) return a->arrival_time < b->arrival_time ? -1 : 1;
+    return (a->pid > b->pid) - (a->pid < b->pid);
+}
+
+typedef struct {
+    sim_time_t arrival;
+    int idx;
+} arrival_key_t;
+
+static int cmp_arrival_key(const void *a, const void *b) {
+    const arrival_key_t *x = a, *y = b;
+    if (x->arrival != y->arrival) return x->arrival < y->arrival ? -1 : 1;
+    return (x->idx > y->idx) - (x->idx < y->idx);
+}
+
+int *arrival_order(const process_hot_t *hot, int n) {
+    int *order = malloc(sizeof(int) * (n > 0 ? n : 1));
+    arrival_key_t *keys = malloc(sizeof(arrival_key_t) * (n > 0 ? n : 1));
+    if (!order || !keys) { free(order); free(keys); return NULL; }
+    for (int i = 0; i < n; ++i) {
+        keys[i].arrival = hot[i].arrival_time;
+        keys[i].idx = i;
+    }
+    qsort(keys, n, sizeof(arrival_key_t), cmp_arrival_key);
+    for (int i = 0; i < n; ++i) order[i] = keys[i].idx;
+    free(keys);
+    return order;
+}
@@ -0,0 +1,189 @@
+/*
+ * replicate.c
+ *
+ * Monte Carlo replication runner. Threads pull the next replication from a
+ * shared counter, generate its workload from its own seed and store the
+ * metrics of each policy in a per-replication slot; means and confidence
+ * intervals are computed afterwards in replication order.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "replicate.h"
+#include "process_store.h"
+#include "timeline.h"
+
+typedef struct {
+    const replicate_config_t *config;
+    metrics_t *results;         // replications * COMPARE_NUM_ALGS
+    int next;                   // next replication to claim
+    int failed;
+    pthread_mutex_t lock;
+} replicate_pool_t;
+
+static int run_one(const replicate_config_t *config, int r, metrics_t *out, metrics_acc_t *acc) {
+    workload_gen_config_t gen = config->workload;
+    gen.seed = config->workload.seed + (uint64_t)r;
+    process_t *processes = NULL;
+    int n = generate_workload(&gen, &processes);
+    if (n <= 0) return -1;
+    process_store_t store;
+    if (process_store_init(&store, processes, n) != 0) { free(processes); return -1; }
+    store.acc = acc;
+    for (int slot = 0; slot < COMPARE_NUM_ALGS; ++slot) {
+        if (!config->selected[slot]) continue;
+        timeline_callback_t counter;
+        timeline_callback_init(&counter, NULL, NULL);
+        if (compare_run_slot(slot, &store, &counter.base) != 0) {
+            process_store_free(&store);
+            free(processes);
+            return -1;
+        }
+        metrics_acc_snapshot(acc, counter.base.total_time, &out[slot]);
+    }
+    process_store_free(&store);
+    free(processes);
+    return 0;
+}
+
+static void *replicate_worker(void *arg) {
+    replicate_pool_t *pool = arg;
+    metrics_acc_t acc;
+    if (metrics_acc_init(&acc) != 0) {
+        pthread_mutex_lock(&pool->lock);
+        pool->failed = 1;
+        pthread_mutex_unlock(&pool->lock);
+        return NULL;
+    }
+    for (;;) {
+        pthread_mutex_lock(&pool->lock);
+        int r = pool->failed ? pool->config->replications : pool->next++;
+        pthread_mutex_unlock(&pool->lock);
+        if (r >= pool->config->replications) break;
+        if (run_one(pool->config, r, &pool->results[(size_t)r * COMPARE_NUM_ALGS], &acc) != 0) {
+            pthread_mutex_lock(&pool->lock);
+            pool->failed = 1;
+            pthread_mutex_unlock(&pool->lock);
+        }
+    }
+    metrics_acc_free(&acc);
+    return NULL;
+}
+
+/* Two-sided 95% Student t critical value for df degrees of freedom. */
+static double t_critical(int df) {
+    static const double table[30] = {
+        12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+        2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+        2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042
+    };
+    if (df <= 0) return 0.0;
+    if (df <= 30) return table[df - 1];
+    // Cornish-Fisher expansion around z = 1.96, well within 0.001 above 30 df
+    double z = 1.959964, d = df;
+    return z + (z * z * z + z) / (4 * d) + (5 * pow(z, 5) + 16 * z * z * z + 3 * z) / (96 * d * d);
+}
+
+/* Mean and CI of field at offset `off` (a double in metrics_t) over all replications of slot. */
+static replicate_ci_t summarize(const metrics_t *results, int reps, int slot, size_t off) {
+    // Welford, in replication order
+    double mean = 0.0, m2 = 0.0;
+    for (int r = 0; r < reps; ++r) {
+        double x = *(const double *)((const char *)&results[(size_t)r * COMPARE_NUM_ALGS + slot] + off);
+        double delta = x - mean;
+        mean += delta / (r + 1);
+        m2 += delta * (x - mean);
+    }
+    replicate_ci_t ci = { mean, 0.0 };
+    if (reps >= 2) ci.half_width = t_critical(reps - 1) * sqrt(m2 / (reps - 1) / reps);
+    return ci;
+}
+
+int run_replications(const replicate_config_t *config, replicate_summary_t *summaries) {
+    int reps = config->replications;
+    if (reps <= 0) { fprintf(stderr, "run_replications: replications must be > 0\n"); return -1; }
+    replicate_pool_t pool;
+    pool.config = config;
+    pool.results = calloc((size_t)reps * COMPARE_NUM_ALGS, sizeof(metrics_t));
+    pool.next = 0;
+    pool.failed = 0;
+    if (!pool.results) { perror("calloc"); return -1; }
+    pthread_mutex_init(&pool.lock, NULL);
+
+    int threads = config->threads;
+    if (threads <= 0) threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    if (threads <= 0) threads = 1;
+    if (threads > reps) threads = reps;
+    pthread_t *tids = malloc(sizeof(pthread_t) * threads);
+    int started = 0;
+    for (int t = 0; tids && t < threads; ++t) {
+        if (pthread_create(&tids[t], NULL, replicate_worker, &pool) != 0) break;
+        started++;
+    }
+    if (started == 0) replicate_worker(&pool);  // no threads available, run inline
+    for (int t = 0; t < started; ++t) pthread_join(tids[t], NULL);
+    free(tids);
+    pthread_mutex_destroy(&pool.lock);
+    if (pool.failed) { free(pool.results); return -1; }
+
+    compare_entry_t names[COMPARE_NUM_ALGS];
+    compare_init(names);
+    int count = 0;
+    for (int slot = 0; slot < COMPARE_NUM_ALGS; ++slot) {
+        if (!config->selected[slot]) continue;
+        replicate_summary_t *s = &summaries[count++];
+        s->policy = names[slot].name;
+        s->avg_turnaround = summarize(pool.results, reps, slot, offsetof(metrics_t, avg_turnaround_time));
+        s->avg_waiting = summarize(pool.results, reps, slot, offsetof(metrics_t, avg_waiting_time));
+        s->avg_response = summarize(pool.results, reps, slot, offsetof(metrics_t, avg_response_time));
+        s->p99_turnaround = summarize(pool.results, reps, slot, offsetof(metrics_t, turnaround.p99));
+        s->cpu_utilization = summarize(pool.results, reps, slot, offsetof(metrics_t, cpu_utilization));
+        s->throughput = summarize(pool.results, reps, slot, offsetof(metrics_t, throughput));
+        s->fairness = summarize(pool.results, reps, slot, offsetof(metrics_t, fairness_index));
+    }
+    free(pool.results);
+    return count;
+}
+
+int write_replications(const char *path, const replicate_config_t *config,
+                       const replicate_summary_t *summaries, int count) {
+    FILE *f = fopen(path, "w");
+    if (!f) { perror("fopen"); return -1; }
+    size_t len = strlen(path);
+    int markdown = (len >= 3 && strcmp(path + len - 3, ".md") == 0);
+
+    if (markdown) {
+        fprintf(f, "# Monte Carlo Replications\n\n");
+        fprintf(f, "%d replications of %d processes, seeds %llu..%llu, 95%% confidence intervals.\n\n",
+                config->replications, config->workload.count,
+                (unsigned long long)config->workload.seed,
+                (unsigned long long)(config->workload.seed + config->replications - 1));
+        fprintf(f, "| Policy | Avg TAT | Avg WT | Avg RT | p99 TAT | CPU %% | Throughput | Fairness |\n");
+        fprintf(f, "|--------|---------|--------|--------|---------|-------|------------|----------|\n");
+    } else {
+        fprintf(f, "policy,metric,mean,ci95_low,ci95_high\n");
+    }
+    for (int i = 0; i < count; ++i) {
+        const replicate_summary_t *s = &summaries[i];
+        const char *labels[7] = {"avg_turnaround", "avg_waiting", "avg_response", "p99_turnaround",
+                                 "cpu_utilization", "throughput", "fairness"};
+        const replicate_ci_t *cis[7] = {&s->avg_turnaround, &s->avg_waiting, &s->avg_response,
+                                        &s->p99_turnaround, &s->cpu_utilization, &s->throughput, &s->fairness};
+        if (markdown) {
+            fprintf(f, "| %s |", s->policy);
+            for (int m = 0; m < 7; ++m)
+                fprintf(f, m >= 5 ? " %.4f ± %.4f |" : " %.2f ± %.2f |", cis[m]->mean, cis[m]->half_width);
+            fprintf(f, "\n");
+        } else {
+            for (int m = 0; m < 7; ++m)
+                fprintf(f, "%s,%s,%.6f,%.6f,%.6f\n", s->policy, labels[m], cis[m]->mean,
+                        cis[m]->mean - cis[m]->half_width, cis[m]->mean + cis[m]->half_width);
+        }
+    }
+    fclose(f);
+    return 0;
+}
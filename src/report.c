@@ -1,53 +1,84 @@
-#include <stdio.h>
-#include "report.h"
-
-void generate_report(const char *filename, process_t *processes, int n, 
-                     metrics_t *metrics_arr, const char **alg_names, int num_algorithms) {
-    FILE *f = fopen(filename, "w");
-    if (!f) { perror("fopen"); return; }
-
-    fprintf(f, "# Scheduler Performance Report\n\n");
-
-    fprintf(f, "## Process Set\n\n");
-    fprintf(f, "| PID | Arrival | Burst | Priority |\n");
-    fprintf(f, "|-----|---------|-------|----------|\n");
-    for (int i = 0; i < n; ++i) {
-        fprintf(f, "| %d   | %d       | %d     | %d        |\n",
-                processes[i].pid,
-                processes[i].arrival_time,
-                processes[i].burst_time,
-                processes[i].priority);
-    }
-    fprintf(f, "\n");
-
-    fprintf(f, "## Algorithm Comparison\n\n");
-    fprintf(f, "| Algorithm | Avg TAT | Avg WT | Avg RT | Throughput |\n");
-    fprintf(f, "|-----------|---------|--------|--------|------------|\n");
-    for (int i = 0; i < num_algorithms; ++i) {
-        fprintf(f, "| %s | %.2f   | %.2f   | %.2f   | %.2f       |\n",
-                alg_names[i],
-                metrics_arr[i].avg_turnaround_time,
-                metrics_arr[i].avg_waiting_time,
-                metrics_arr[i].avg_response_time,
-                metrics_arr[i].throughput);
-    }
-    fprintf(f, "\n");
-
-    // Determine best algorithm (lowest Avg TAT)
-    int best_idx = 0;
-    for (int i = 1; i < num_algorithms; ++i) {
-        if (metrics_arr[i].avg_turnaround_time < metrics_arr[best_idx].avg_turnaround_time) {
-            best_idx = i;
-        }
-    }
-    fprintf(f, "## Best Algorithm for This Workload\n");
-    fprintf(f, "**%s** - Lowest average turnaround time and waiting time\n\n", alg_names[best_idx]);
-
-    fprintf(f, "## Recommendations\n");
-    fprintf(f, "- Interactive processes: Use MLFQ or RR\n");
-    fprintf(f, "- Batch jobs: Use SJF or STCF\n");
-    fprintf(f, "- Mixed workload: Use MLFQ with appropriate tuning\n");
-
-    fclose(f);
-}
-
+#include <stdio.h>
+#include "report.h"
+
+void generate_report(const char *filename, process_t *processes, int n, 
+                     metrics_t *metrics_arr, const sched_stats_t *stats_arr,
+                     const char **alg_names, int num_algorithms) {
+    FILE *f = fopen(filename, "w");
+    if (!f) { perror("fopen"); return; }
+
+    fprintf(f, "# Scheduler Performance Report\n\n");
+
+    fprintf(f, "## Process Set\n\n");
+    fprintf(f, "| PID | Arrival | Burst | Priority |\n");
+    fprintf(f, "|-----|---------|-------|----------|\n");
+    for (int i = 0; i < n; ++i) {
+        fprintf(f, "| %d   | %lld       | %lld     | %d        |\n",
+                processes[i].pid,
+                processes[i].arrival_time,
+                processes[i].burst_time,
+                processes[i].priority);
+    }
+    fprintf(f, "\n");
+
+    fprintf(f, "## Algorithm Comparison\n\n");
+    fprintf(f, "| Algorithm | Avg TAT | Avg WT | Avg RT | Throughput |\n");
+    fprintf(f, "|-----------|---------|--------|--------|------------|\n");
+    for (int i = 0; i < num_algorithms; ++i) {
+        fprintf(f, "| %s | %.2f   | %.2f   | %.2f   | %.2f       |\n",
+                alg_names[i],
+                metrics_arr[i].avg_turnaround_time,
+                metrics_arr[i].avg_waiting_time,
+                metrics_arr[i].avg_response_time,
+                metrics_arr[i].throughput);
+    }
+    fprintf(f, "\n");
+
+    fprintf(f, "## Tail Latency\n\n");
+    fprintf(f, "| Algorithm | Metric | p50 | p90 | p99 | p99.9 | Max |\n");
+    fprintf(f, "|-----------|--------|-----|-----|-----|-------|-----|\n");
+    for (int i = 0; i < num_algorithms; ++i) {
+        const char *labels[3] = {"TAT", "WT", "RT"};
+        const latency_tail_t *tails[3] = {
+            &metrics_arr[i].turnaround, &metrics_arr[i].waiting, &metrics_arr[i].response
+        };
+        for (int m = 0; m < 3; ++m)
+            fprintf(f, "| %s | %s | %.0f | %.0f | %.0f | %.0f | %.0f |\n",
+                    alg_names[i], labels[m], tails[m]->p50, tails[m]->p90,
+                    tails[m]->p99, tails[m]->p999, tails[m]->max);
+    }
+    fprintf(f, "\n");
+
+    if (stats_arr) {
+        fprintf(f, "## Scheduler Counters\n\n");
+        fprintf(f, "| Algorithm | Dispatches | Pushes | Pops | Scans | Preemptions | Idle Gaps | Demotions | Boosts | Events |\n");
+        fprintf(f, "|-----------|------------|--------|------|-------|-------------|-----------|-----------|--------|--------|\n");
+        for (int i = 0; i < num_algorithms; ++i) {
+            const sched_stats_t *st = &stats_arr[i];
+            fprintf(f, "| %s | %lld | %lld | %lld | %lld | %lld | %lld | %lld | %lld | %lld |\n",
+                    alg_names[i], st->dispatches, st->queue_pushes, st->queue_pops, st->candidate_scans,
+                    st->preemptions, st->idle_gaps, st->demotions, st->boosts, st->timeline_events);
+        }
+        fprintf(f, "\n");
+    }
+
+    // Determine best algorithm (lowest Avg TAT)
+    int best_idx = 0;
+    for (int i = 1; i < num_algorithms; ++i) {
+        if (metrics_arr[i].avg_turnaround_time < metrics_arr[best_idx].avg_turnaround_time) {
+            best_idx = i;
+        }
+    }
+    fprintf(f, "## Best Algorithm for This Workload\n");
+    fprintf(f, "**%s** - Lowest average turnaround time and waiting time\n\n", alg_names[best_idx]);
+
+    fprintf(f, "## Recommendations\n");
+    fprintf(f, "- Interactive processes: Use MLFQ or RR\n");
+    fprintf(f, "- Batch jobs: Use SJF or STCF\n");
+    fprintf(f, "- Mixed workload: Use MLFQ with appropriate tuning\n");
+    fprintf(f, "- Priority-tagged jobs: Use PRIO or PPRIO, with aging so low priorities still progress\n");
+    fprintf(f, "- CPU shares proportional to priority: Use STRIDE (deterministic), LOTTERY or CFS\n");
+
+    fclose(f);
+}
+
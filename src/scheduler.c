@@ -1,200 +1,472 @@
-/*
- * scheduler.c
- *
- * Main program: loads workload file, runs chosen algorithm, computes metrics,
- * optionally invokes ncurses GUI, and can write a report.
- *
- * Usage examples:
- *   ./scheduler workloads/workload1.txt fifo
- *   ./scheduler workloads/workload1.txt rr 3
- *   ./scheduler workloads/workload1.txt mlfq 3 "4,8,16" 50
- *
- */
-
-#include <stdio.h>
-#include <stdlib.h>
-#include <string.h>
-#include <ctype.h>
-
-#include "scheduler.h"
-#include "algorithms.h"
-#include "metrics.h"
-#include "report.h"  // generate_report
-
-/* read workload file; format: lines with "arrival burst priority" */
-int load_workload(const char *path, process_t **out_processes) {
-    FILE *f = fopen(path, "r");
-    if (!f) { perror("fopen"); return -1; }
-    int capacity = 32;
-    process_t *list = malloc(sizeof(process_t) * capacity);
-    int count = 0;
-    int pid_counter = 1;
-    while (!feof(f)) {
-        int arrival, burst, priority;
-        if (fscanf(f, "%d %d %d", &arrival, &burst, &priority) == 3) {
-            if (count >= capacity) {
-                capacity *= 2;
-                list = realloc(list, sizeof(process_t) * capacity);
-            }
-            list[count].pid = pid_counter++;
-            list[count].arrival_time = arrival;
-            list[count].burst_time = burst;
-            list[count].priority = priority;
-            count++;
-        } else {
-            char buf[256];
-            if (!fgets(buf, sizeof(buf), f)) break;
-        }
-    }
-    fclose(f);
-    *out_processes = list;
-    return count;
-}
-
-/* compute total_time from timeline */
-int compute_total_time(timeline_event_t *timeline, int tlen) {
-    int total = 0;
-    for (int i = 0; i < tlen; ++i) total += timeline[i].duration;
-    return total;
-}
-
-/* optional: print timeline for debug */
-static void print_timeline(timeline_event_t *timeline, int tlen) {
-    printf("Timeline events:\n");
-    for (int i = 0; i < tlen; ++i) {
-        printf("  time=%d pid=%d dur=%d\n", timeline[i].time, timeline[i].pid, timeline[i].duration);
-    }
-}
-
-int main(int argc, char **argv) {
-    if (argc < 3) {
-        printf("Usage: %s <workload_file> <algorithm> [params...]\n", argv[0]);
-        printf("Algorithms: fifo, sjf, stcf, rr <quantum>, mlfq <num_q> <comma_quants> <boost_interval>\n");
-        return 1;
-    }
-
-    const char *workload = argv[1];
-    const char *alg = argv[2];
-
-    process_t *processes = NULL;
-    int n = load_workload(workload, &processes);
-    if (n <= 0) { fprintf(stderr, "No processes loaded.\n"); return 2; }
-
-    // allocate timeline
-    int max_events = 10000;
-    timeline_event_t *timeline = malloc(sizeof(timeline_event_t) * max_events);
-    int tlen = 0;
-
-    metrics_t metrics; // for the selected algorithm
-
-    // copy of processes for safety
-    process_t *orig = malloc(sizeof(process_t)*n);
-    memcpy(orig, processes, sizeof(process_t)*n);
-
-    // run selected algorithm
-    if (strcmp(alg, "fifo") == 0) {
-        schedule_fifo(processes, n, timeline, &tlen);
-    } else if (strcmp(alg, "sjf") == 0) {
-        schedule_sjf(processes, n, timeline, &tlen);
-    } else if (strcmp(alg, "stcf") == 0) {
-        schedule_stcf(processes, n, timeline, &tlen);
-    } else if (strcmp(alg, "rr") == 0) {
-        if (argc < 4) { fprintf(stderr, "rr requires quantum param\n"); return 3; }
-        int q = atoi(argv[3]);
-        if (q <= 0) { fprintf(stderr, "quantum must be > 0\n"); return 3; }
-        schedule_rr(processes, n, q, timeline, &tlen);
-    } else if (strcmp(alg, "mlfq") == 0) {
-        if (argc < 6) { fprintf(stderr, "mlfq requires num_queues quantums_csv boost_interval\n"); return 3; }
-        int numq = atoi(argv[3]);
-        char *csv = argv[4];
-        int boost = atoi(argv[5]);
-        int *quantums = malloc(sizeof(int)*numq);
-        char *tmp = strdup(csv);
-        char *tok = strtok(tmp, ",");
-        int i = 0;
-        while (tok && i < numq) {
-            quantums[i++] = atoi(tok);
-            tok = strtok(NULL, ",");
-        }
-        free(tmp);
-        if (i != numq) { fprintf(stderr, "quantums count mismatch\n"); return 4; }
-        mlfq_config_t cfg;
-        cfg.num_queues = numq;
-        cfg.quantums = quantums;
-        cfg.boost_interval = boost;
-        schedule_mlfq(processes, n, &cfg, timeline, &tlen);
-        free(quantums);
-    } else {
-        fprintf(stderr, "Unknown algorithm '%s'\n", alg);
-        return 4;
-    }
-
-    // calculate metrics
-    int total_time = compute_total_time(timeline, tlen);
-    calculate_metrics(processes, n, total_time, &metrics);
-
-    // textual output
-    printf("Algorithm: %s\n", alg);
-    printf("Processes:\n");
-    for (int i = 0; i < n; ++i) {
-        printf("PID %d: arrival=%d burst=%d priority=%d start=%d completion=%d tat=%d wt=%d rt=%d\n",
-               processes[i].pid, processes[i].arrival_time, processes[i].burst_time, processes[i].priority,
-               processes[i].start_time, processes[i].completion_time,
-               processes[i].turnaround_time, processes[i].waiting_time, processes[i].response_time);
-    }
-    print_timeline(timeline, tlen);
-    printf("\nMetrics:\n");
-    printf("Avg Turnaround Time: %.2f\n", metrics.avg_turnaround_time);
-    printf("Avg Waiting Time:    %.2f\n", metrics.avg_waiting_time);
-    printf("Avg Response Time:   %.2f\n", metrics.avg_response_time);
-    printf("CPU Utilization:     %.2f%%\n", metrics.cpu_utilization);
-    printf("Throughput:          %.4f\n", metrics.throughput);
-    printf("Fairness Index:      %.4f\n", metrics.fairness_index);
-
-    // optional GUI
-    printf("\nLaunch ncurses GUI? (y/N): ");
-    int c = getchar();
-    if (c == 'y' || c == 'Y') {
-        extern void render_gui(process_t *processes, int n, timeline_event_t *timeline, int tlen,
-                               metrics_t *metrics, const char *algorithm_name, int quantum);
-        int q = 0;
-        if (strcmp(alg,"rr")==0 && argc>=4) q = atoi(argv[3]);
-        render_gui(processes, n, timeline, tlen, &metrics, alg, q);
-    }
-
-    // generate comparison report for all algorithms
-    {
-        metrics_t all_metrics[5];
-        const char *alg_names[] = {"FIFO","SJF","STCF","RR","MLFQ"};
-        for (int i=0; i<5; i++) {
-            process_t *copy = malloc(sizeof(process_t)*n);
-            memcpy(copy, processes, sizeof(process_t)*n);
-            int tlen_copy = 0;
-            timeline_event_t *timeline_copy = malloc(sizeof(timeline_event_t)*max_events);
-            switch(i) {
-                case 0: schedule_fifo(copy,n,timeline_copy,&tlen_copy); break;
-                case 1: schedule_sjf(copy,n,timeline_copy,&tlen_copy); break;
-                case 2: schedule_stcf(copy,n,timeline_copy,&tlen_copy); break;
-                case 3: schedule_rr(copy,n,3,timeline_copy,&tlen_copy); break; // quantum=3
-                case 4: {
-                    mlfq_config_t cfg = {3, (int[]){4,8,16}, 50};
-                    schedule_mlfq(copy,n,&cfg,timeline_copy,&tlen_copy);
-                    break;
-                }
-            }
-            metrics_t m;
-            calculate_metrics(copy,n,compute_total_time(timeline_copy,tlen_copy),&m);
-            all_metrics[i] = m;
-            free(copy);
-            free(timeline_copy);
-        }
-        generate_report("report.md", processes, n, all_metrics, alg_names, 5);
-        printf("\nReport generated: report.md\n");
-    }
-
-    free(processes);
-    free(orig);
-    free(timeline);
-    return 0;
-}
-
+/*
+ * scheduler.c
+ *
+ * Main program: loads workload file, runs chosen algorithm, computes metrics,
+ * optionally invokes ncurses GUI, and can write a report.
+ *
+ * Usage examples:
+ *   ./scheduler workloads/workload1.txt fifo
+ *   ./scheduler workloads/workload1.txt rr 3
+ *   ./scheduler workloads/workload1.txt mlfq 3 "4,8,16" 50
+ *   ./scheduler workloads/workload1.txt ppriority 50
+ *   ./scheduler workloads/workload1.txt cfs 24 3
+ *   ./scheduler workloads/workload1.txt sweep 1:8 2:4 2:8:2 0:100:50 sweep.csv
+ *   ./gen_workload -n 10000000 -o /dev/stdout | ./scheduler - stream rr 3
+ *   ./scheduler workloads/workload3.txt smp 4 mlfq 3 "4,8,16" 50
+ *   ./scheduler - replicate 200 5000 rr,mlfq 1 0 replications.md
+ *   ./scheduler workloads/big.txt checkpoint 500000 big.ckpt mlfq 3 "4,8,16" 50
+ *   ./scheduler workloads/big.txt resume big.ckpt mlfq 3 "4,8,16" 100
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+#include "scheduler.h"
+#include "timeline.h"
+#include "process_store.h"
+#include "algorithms.h"
+#include "metrics.h"
+#include "report.h"  // generate_report
+#include "compare.h"
+#include "engine.h"
+#include "policy.h"
+#include "sweep.h"
+#include "workload.h"
+#include "stream.h"
+#include "smp.h"
+#include "replicate.h"
+
+/* optional: print timeline for debug */
+static void print_timeline(timeline_event_t *timeline, size_t tlen) {
+    printf("Timeline events:\n");
+    for (size_t i = 0; i < tlen; ++i) {
+        printf("  time=%lld pid=%d dur=%lld\n", timeline[i].time, timeline[i].pid, timeline[i].duration);
+    }
+}
+
+static void print_tail(const char *name, const latency_tail_t *t) {
+    printf("%-12s %9.0f %9.0f %9.0f %9.0f %9.0f\n", name, t->p50, t->p90, t->p99, t->p999, t->max);
+}
+
+static void print_metrics(const metrics_t *metrics) {
+    printf("\nMetrics:\n");
+    printf("Avg Turnaround Time: %.2f\n", metrics->avg_turnaround_time);
+    printf("Avg Waiting Time:    %.2f\n", metrics->avg_waiting_time);
+    printf("Avg Response Time:   %.2f\n", metrics->avg_response_time);
+    printf("CPU Utilization:     %.2f%%\n", metrics->cpu_utilization);
+    printf("Throughput:          %.4f\n", metrics->throughput);
+    printf("Fairness Index:      %.4f\n", metrics->fairness_index);
+    printf("\n%-12s %9s %9s %9s %9s %9s\n", "Percentiles", "p50", "p90", "p99", "p99.9", "max");
+    print_tail("Turnaround", &metrics->turnaround);
+    print_tail("Waiting", &metrics->waiting);
+    print_tail("Response", &metrics->response);
+}
+
+/* counters from an instrumented build (make STATS=1) */
+static void print_stats(const sched_stats_t *st) {
+    printf("\nScheduler counters:\n");
+    printf("Dispatches:          %lld\n", st->dispatches);
+    printf("Queue pushes/pops:   %lld / %lld\n", st->queue_pushes, st->queue_pops);
+    printf("Candidate scans:     %lld\n", st->candidate_scans);
+    printf("Preemptions:         %lld\n", st->preemptions);
+    printf("Idle gaps:           %lld\n", st->idle_gaps);
+    printf("Demotions/boosts:    %lld / %lld\n", st->demotions, st->boosts);
+    printf("Timeline events:     %lld\n", st->timeline_events);
+}
+
+/* online mode: "<workload|-> stream <algorithm> [params...] [snapshot_every]" */
+static int stream_main(int argc, char **argv) {
+    if (argc < 4) { fprintf(stderr, "stream requires an algorithm\n"); return 3; }
+    int slot = policy_find(argv[3]);
+    if (slot < 0) { fprintf(stderr, "Unknown algorithm '%s'\n", argv[3]); return 4; }
+    const policy_entry_t *policy = policy_get(slot);
+    if (!stream_supports(policy)) { fprintf(stderr, "%s is not supported in stream mode\n", policy->name); return 4; }
+    policy_params_t params = {0};
+    int rc = policy->parse(argc - 4, &argv[4], &params);
+    if (rc != 0) return rc;
+    stream_config_t sc;
+    sc.policy = policy;
+    sc.params = &params;
+    sc.results = stdout;
+    sc.timeline = NULL;
+    int next_arg = 4 + policy->max_args;   // first argument after the policy parameters
+    sc.snapshot_every = (argc > next_arg) ? atol(argv[next_arg]) : 0;
+
+    metrics_acc_t acc;
+    if (metrics_acc_init(&acc) != 0) { free(params.mlfq.quantums); return 5; }
+    sc.metrics = &acc;
+
+    workload_reader_t reader;
+    if (workload_reader_open(&reader, argv[1]) != 0) { metrics_acc_free(&acc); free(params.mlfq.quantums); return 2; }
+    stream_stats_t stats;
+    printf("Algorithm: %s (stream)\n", policy->name);
+    printf("Processes:\n");
+    rc = run_stream(&reader, &sc, &stats);
+    workload_reader_close(&reader);
+    free(params.mlfq.quantums);
+    printf("\nStreamed %ld processes, total time %lld, peak active %d\n",
+           stats.retired, stats.total_time, stats.peak_active);
+    metrics_t metrics;
+    metrics_acc_snapshot(&acc, stats.total_time, &metrics);
+    print_metrics(&metrics);
+    metrics_acc_free(&acc);
+    return rc == 0 ? 0 : 5;
+}
+
+/* multi-CPU mode: "<workload> smp <cores> <fifo|rr|mlfq> [params...] [nosteal]" */
+static int smp_main(int argc, char **argv) {
+    if (argc < 5) { fprintf(stderr, "smp requires cores and an algorithm\n"); return 3; }
+    smp_config_t sc;
+    mlfq_config_t cfg = {0, NULL, 0};
+    sc.num_cores = atoi(argv[3]);
+    sc.quantum = 0;
+    sc.mlfq = NULL;
+    sc.steal = 1;
+    if (sc.num_cores < 1 || sc.num_cores > SMP_MAX_CORES) {
+        fprintf(stderr, "cores must be 1..%d\n", SMP_MAX_CORES);
+        return 3;
+    }
+    if (smp_policy_from_name(argv[4], &sc.policy) != 0) {
+        fprintf(stderr, "Unknown SMP algorithm '%s' (fifo, rr or mlfq)\n", argv[4]);
+        return 4;
+    }
+    int next_arg = 5;   // first argument after the policy parameters
+    if (sc.policy == SMP_RR) {
+        if (argc < 6) { fprintf(stderr, "rr requires quantum param\n"); return 3; }
+        sc.quantum = atoi(argv[5]);
+        if (sc.quantum <= 0) { fprintf(stderr, "quantum must be > 0\n"); return 3; }
+        next_arg = 6;
+    } else if (sc.policy == SMP_MLFQ) {
+        if (argc < 8) { fprintf(stderr, "mlfq requires num_queues quantums_csv boost_interval\n"); return 3; }
+        int rc = policy_parse_mlfq(&argv[5], &cfg);
+        if (rc != 0) return rc;
+        sc.mlfq = &cfg;
+        next_arg = 8;
+    }
+    if (argc > next_arg && strcmp(argv[next_arg], "nosteal") == 0) sc.steal = 0;
+
+    process_t *processes = NULL;
+    int n = load_workload(argv[1], &processes);
+    if (n <= 0) { fprintf(stderr, "No processes loaded.\n"); free(cfg.quantums); return 2; }
+    process_store_t store;
+    if (process_store_init(&store, processes, n) != 0) { free(processes); free(cfg.quantums); return 5; }
+    timeline_buffer_t timeline;
+    timeline_buffer_init(&timeline);
+    smp_stats_t stats;
+    if (schedule_smp(&store, &sc, &timeline.base, &stats) != 0 || timeline.base.error) {
+        process_store_free(&store);
+        timeline_buffer_free(&timeline);
+        free(processes);
+        free(cfg.quantums);
+        return 5;
+    }
+    metrics_t metrics;
+    calculate_metrics(&store, stats.elapsed, &metrics);
+    metrics.cpu_utilization = stats.aggregate_utilization;  // busy time is spread over all cores
+    process_store_export(&store, processes);
+
+    printf("Algorithm: %s on %d cores%s\n", argv[4], sc.num_cores, sc.steal ? "" : " (no stealing)");
+    printf("Processes:\n");
+    for (int i = 0; i < n; ++i) {
+        printf("PID %d: arrival=%lld burst=%lld priority=%d start=%lld completion=%lld tat=%lld wt=%lld rt=%lld\n",
+               processes[i].pid, processes[i].arrival_time, processes[i].burst_time, processes[i].priority,
+               processes[i].start_time, processes[i].completion_time,
+               processes[i].turnaround_time, processes[i].waiting_time, processes[i].response_time);
+    }
+    printf("Timeline events:\n");
+    for (int c = 0; c < sc.num_cores; ++c) {
+        printf(" Core %d:\n", c);
+        for (size_t i = 0; i < timeline.len; ++i) {
+            const timeline_event_t *ev = &timeline.events[i];
+            if (ev->core == c) printf("  time=%lld pid=%d dur=%lld\n", ev->time, ev->pid, ev->duration);
+        }
+    }
+    print_metrics(&metrics);
+    printf("\n%-6s %10s %10s %10s\n", "Core", "Busy", "Util %", "Dispatches");
+    for (int c = 0; c < sc.num_cores; ++c)
+        printf("%-6d %10lld %10.2f %10lld\n", c, stats.busy[c], stats.utilization[c], stats.dispatches[c]);
+    printf("Aggregate utilization: %.2f%%\n", stats.aggregate_utilization);
+    printf("Migrations:            %lld (%lld steals)\n", stats.migrations, stats.steals);
+    printf("Load imbalance:        %.4f (max/mean core busy - 1)\n", stats.imbalance);
+
+    process_store_free(&store);
+    timeline_buffer_free(&timeline);
+    free(processes);
+    free(cfg.quantums);
+    return 0;
+}
+
+/* Monte Carlo mode: "- replicate <replications> <processes> [policies|all] [seed] [threads] [out.csv|out.md]" */
+static int replicate_main(int argc, char **argv) {
+    if (argc < 5) { fprintf(stderr, "replicate requires replications and processes\n"); return 3; }
+    replicate_config_t rc;
+    workload_gen_defaults(&rc.workload);
+    rc.replications = atoi(argv[3]);
+    rc.workload.count = atoi(argv[4]);
+    if (rc.replications < 2 || rc.workload.count <= 0) {
+        fprintf(stderr, "need at least 2 replications and 1 process\n");
+        return 3;
+    }
+    const char *list = (argc >= 6) ? argv[5] : "all";
+    for (int i = 0; i < COMPARE_NUM_ALGS; ++i) rc.selected[i] = (strcmp(list, "all") == 0);
+    if (strcmp(list, "all") != 0) {
+        char *tmp = strdup(list);
+        for (char *tok = strtok(tmp, ","); tok; tok = strtok(NULL, ",")) {
+            int slot = policy_find(tok);
+            if (slot < 0) { fprintf(stderr, "Unknown algorithm '%s'\n", tok); free(tmp); return 4; }
+            rc.selected[slot] = 1;
+        }
+        free(tmp);
+    }
+    if (argc >= 7) rc.workload.seed = strtoull(argv[6], NULL, 10);
+    rc.threads = (argc >= 8) ? atoi(argv[7]) : 0;
+
+    replicate_summary_t summaries[COMPARE_NUM_ALGS];
+    int count = run_replications(&rc, summaries);
+    if (count < 0) return 5;
+    printf("Replications: %d x %d processes, seeds %llu..%llu\n",
+           rc.replications, rc.workload.count, (unsigned long long)rc.workload.seed,
+           (unsigned long long)(rc.workload.seed + rc.replications - 1));
+    printf("%-6s %22s %22s %22s %22s %18s\n", "Policy", "Avg TAT (95% CI)", "Avg WT (95% CI)",
+           "Avg RT (95% CI)", "p99 TAT (95% CI)", "CPU % (95% CI)");
+    for (int i = 0; i < count; ++i) {
+        const replicate_summary_t *s = &summaries[i];
+        printf("%-6s %12.2f ± %7.2f %12.2f ± %7.2f %12.2f ± %7.2f %12.2f ± %7.2f %9.2f ± %6.2f\n", s->policy,
+               s->avg_turnaround.mean, s->avg_turnaround.half_width, s->avg_waiting.mean, s->avg_waiting.half_width,
+               s->avg_response.mean, s->avg_response.half_width, s->p99_turnaround.mean,
+               s->p99_turnaround.half_width, s->cpu_utilization.mean, s->cpu_utilization.half_width);
+    }
+    if (argc >= 9) {
+        if (write_replications(argv[8], &rc, summaries, count) != 0) return 5;
+        printf("Replication summary written to %s\n", argv[8]);
+    }
+    return 0;
+}
+
+/*
+ * "<workload> checkpoint <time> <file> <algorithm> [params...]" runs up to time and saves the run;
+ * "<workload> resume <file> <algorithm> [params...]" finishes a saved one, possibly with other params.
+ */
+static int checkpoint_main(int argc, char **argv) {
+    int resume = strcmp(argv[2], "resume") == 0;
+    int alg_arg = resume ? 4 : 5;
+    if (argc <= alg_arg) {
+        fprintf(stderr, resume ? "resume requires a checkpoint file and an algorithm\n"
+                               : "checkpoint requires a time, a file and an algorithm\n");
+        return 3;
+    }
+    const char *path = argv[alg_arg - 1];
+    sim_time_t until = resume ? SLICE_UNLIMITED : atoll(argv[3]);
+    int slot = policy_find(argv[alg_arg]);
+    if (slot < 0) { fprintf(stderr, "Unknown algorithm '%s'\n", argv[alg_arg]); return 4; }
+    const policy_entry_t *policy = policy_get(slot);
+    policy_params_t params = {0};
+    int rc = policy->parse(argc - alg_arg - 1, &argv[alg_arg + 1], &params);
+    if (rc != 0) return rc;
+
+    process_t *processes = NULL;
+    int n = load_workload(argv[1], &processes);
+    if (n <= 0) { fprintf(stderr, "No processes loaded.\n"); free(params.mlfq.quantums); return 2; }
+    process_store_t store;
+    rc = process_store_init(&store, processes, n);
+    free(processes);
+    if (rc != 0) { free(params.mlfq.quantums); return 5; }
+    sched_stats_t stats = {0};
+    store.stats = &stats;
+    timeline_callback_t timeline;   // events are only counted
+    timeline_callback_init(&timeline, NULL, NULL);
+
+    engine_t engine;
+    if (resume) {
+        FILE *in = fopen(path, "rb");
+        if (!in) { perror(path); rc = 2; }
+        else {
+            if (engine_resume(&engine, &store, policy->ops, &params, &timeline.base, in) != 0) rc = 2;
+            fclose(in);
+        }
+    } else if (engine_start(&engine, &store, policy->ops, &params) != 0) {
+        rc = 5;
+    }
+    if (rc == 0) {
+        sim_time_t from = engine.time;
+        engine_advance(&engine, until, &timeline.base);
+        if (resume) {
+            metrics_t metrics;
+            calculate_metrics(&store, timeline.base.total_time, &metrics);
+            printf("Algorithm: %s (resumed at time %lld from %s)\n", argv[alg_arg], (long long)from, path);
+            print_metrics(&metrics);
+            if (SCHED_STATS_ENABLED) print_stats(&stats);
+        } else {
+            FILE *out = fopen(path, "wb");
+            if (!out) { perror(path); rc = 5; }
+            else {
+                if (engine_checkpoint(&engine, &timeline.base, out) != 0) rc = 5;
+                if (fclose(out) != 0) rc = 5;
+            }
+            if (rc == 0)
+                printf("Checkpoint at time %lld: %d of %d processes completed, written to %s\n",
+                       (long long)engine.time, engine.completed, n, path);
+        }
+        engine_free(&engine);
+    }
+    free(params.mlfq.quantums);
+    process_store_free(&store);
+    return rc;
+}
+
+int main(int argc, char **argv) {
+    if (argc < 3) {
+        printf("Usage: %s <workload_file> <algorithm> [params...]\n", argv[0]);
+        printf("Algorithms:\n");
+        policy_print_usage(stdout, "            ");
+        printf("Sweep:      sweep <rr_quanta> <mlfq_queues> <mlfq_base_quantum> <mlfq_boost> [out.csv|out.md] [threads]\n");
+        printf("            ranges are v, lo:hi or lo:hi:step; '-' skips that policy\n");
+        printf("Stream:     stream <fifo|sjf|stcf|rr|mlfq> [params...] [snapshot_every]  (workload '-' reads stdin; input sorted by arrival)\n");
+        printf("SMP:        smp <cores> <fifo|rr|mlfq> [params...] [nosteal]\n");
+        printf("Replicate:  replicate <replications> <processes> [fifo,sjf,...|all] [seed] [threads] [out.csv|out.md]\n");
+        printf("            (workload argument unused: each replication generates its own, e.g. '-')\n");
+        printf("Checkpoint: checkpoint <time> <file> <algorithm> [params...]  (run up to time, save the state)\n");
+        printf("Resume:     resume <file> <algorithm> [params...]  (same workload and algorithm; params may differ)\n");
+        return 1;
+    }
+
+    if (strcmp(argv[2], "stream") == 0) return stream_main(argc, argv);
+    if (strcmp(argv[2], "smp") == 0) return smp_main(argc, argv);
+    if (strcmp(argv[2], "replicate") == 0) return replicate_main(argc, argv);
+    if (strcmp(argv[2], "checkpoint") == 0 || strcmp(argv[2], "resume") == 0) return checkpoint_main(argc, argv);
+
+    const char *workload = argv[1];
+    const char *alg = argv[2];
+
+    // parameters of the selected run, kept so the report can reuse its result;
+    // checked before anything is loaded or allocated
+    policy_params_t params = {0};
+    const policy_entry_t *policy = NULL;
+    sweep_config_t sc;      // sweep only
+    if (strcmp(alg, "sweep") != 0) {
+        int slot = policy_find(alg);
+        if (slot < 0) {
+            fprintf(stderr, "Unknown algorithm '%s'\n", alg);
+            return 4;
+        }
+        policy = policy_get(slot);
+        int rc = policy->parse(argc - 3, &argv[3], &params);
+        if (rc != 0) return rc;
+    } else {
+        if (argc < 7) { fprintf(stderr, "sweep requires rr_quanta mlfq_queues mlfq_base_quantum mlfq_boost\n"); return 3; }
+        if (parse_range(argv[3], &sc.rr_quantum) != 0 || parse_range(argv[4], &sc.mlfq_queues) != 0 ||
+            parse_range(argv[5], &sc.mlfq_base_quantum) != 0 || parse_range(argv[6], &sc.mlfq_boost) != 0) {
+            fprintf(stderr, "bad range (use v, lo:hi or lo:hi:step)\n");
+            return 3;
+        }
+        if ((sc.rr_quantum.hi >= sc.rr_quantum.lo && sc.rr_quantum.lo <= 0) ||
+            (sc.mlfq_queues.hi >= sc.mlfq_queues.lo && sc.mlfq_queues.lo <= 0) ||
+            (sc.mlfq_base_quantum.hi >= sc.mlfq_base_quantum.lo && sc.mlfq_base_quantum.lo <= 0)) {
+            fprintf(stderr, "quantums and queue counts must be > 0\n");
+            return 3;
+        }
+        sc.threads = (argc >= 9) ? atoi(argv[8]) : 0;
+    }
+
+    process_t *processes = NULL;
+    int n = load_workload(workload, &processes);
+    if (n <= 0) { fprintf(stderr, "No processes loaded.\n"); free(params.mlfq.quantums); return 2; }
+
+    if (!policy) {
+        const char *out = (argc >= 8) ? argv[7] : "sweep.csv";
+        sweep_point_t *points = NULL;
+        int count = run_sweep(processes, n, &sc, &points);
+        if (count < 0 || write_sweep(out, points, count) != 0) { free(points); free(processes); return 5; }
+        printf("Sweep: %d configurations written to %s\n", count, out);
+        free(points);
+        free(processes);
+        return 0;
+    }
+
+    // timeline grows as the scheduler emits events
+    timeline_buffer_t timeline;
+    timeline_buffer_init(&timeline);
+
+    metrics_t metrics; // for the selected algorithm
+    int rc = 0;
+
+    // the schedulers run on the hot/cold store; results are copied back for output
+    process_store_t store = {0};
+    sched_stats_t stats = {0};
+    if (process_store_init(&store, processes, n) != 0) { rc = 5; goto out; }
+    store.stats = &stats;   // stays zero unless built with SCHED_STATS
+
+    // run selected algorithm
+    if (engine_run(&store, policy->ops, &params, &timeline.base) != 0 || timeline.base.error) { rc = 5; goto out; }
+
+    // calculate metrics
+    sim_time_t total_time = timeline.base.total_time;
+    calculate_metrics(&store, total_time, &metrics);
+    process_store_export(&store, processes);
+
+    // textual output
+    printf("Algorithm: %s\n", alg);
+    printf("Processes:\n");
+    for (int i = 0; i < n; ++i) {
+        printf("PID %d: arrival=%lld burst=%lld priority=%d start=%lld completion=%lld tat=%lld wt=%lld rt=%lld\n",
+               processes[i].pid, processes[i].arrival_time, processes[i].burst_time, processes[i].priority,
+               processes[i].start_time, processes[i].completion_time,
+               processes[i].turnaround_time, processes[i].waiting_time, processes[i].response_time);
+    }
+    print_timeline(timeline.events, timeline.len);
+    print_metrics(&metrics);
+    if (SCHED_STATS_ENABLED) print_stats(&stats);
+
+    // optional GUI
+    printf("\nLaunch ncurses GUI? (y/N): ");
+    int c = getchar();
+    if (c == 'y' || c == 'Y') {
+        extern void render_gui(process_t *processes, int n, timeline_event_t *timeline, int tlen,
+                               metrics_t *metrics, const char *algorithm_name, int quantum);
+        render_gui(processes, n, timeline.events, timeline.len, &metrics, alg, params.quantum);
+    }
+
+    // generate comparison report for all algorithms (run in parallel, reusing the selected run)
+    {
+        compare_entry_t entries[COMPARE_NUM_ALGS];
+        compare_init(entries);
+        int slot = compare_find(alg, &params);
+        if (slot >= 0) {
+            entries[slot].metrics = metrics;
+            entries[slot].stats = stats;
+            entries[slot].precomputed = 1;
+        }
+        if (run_comparison(processes, n, entries) != 0) rc = 5;
+        // failed runs have no valid metrics, so they are left out of the report
+        metrics_t all_metrics[COMPARE_NUM_ALGS];
+        sched_stats_t all_stats[COMPARE_NUM_ALGS];
+        const char *alg_names[COMPARE_NUM_ALGS];
+        int count = 0;
+        for (int i = 0; i < COMPARE_NUM_ALGS; ++i) {
+            if (entries[i].failed) {
+                fprintf(stderr, "%s: comparison run failed, left out of the report\n", entries[i].name);
+                continue;
+            }
+            all_metrics[count] = entries[i].metrics;
+            all_stats[count] = entries[i].stats;
+            alg_names[count] = entries[i].name;
+            count++;
+        }
+        if (count > 0) {
+            generate_report("report.md", processes, n, all_metrics, SCHED_STATS_ENABLED ? all_stats : NULL,
+                            alg_names, count);
+            printf("\nReport generated: report.md\n");
+        }
+    }
+
+out:
+    free(processes);
+    free(params.mlfq.quantums);
+    process_store_free(&store);
+    timeline_buffer_free(&timeline);
+    return rc;
+}
+
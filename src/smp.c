@@ -0,0 +1,318 @@
+/*
+ * smp.c
+ *
+ * Event-driven SMP simulation of FIFO, RR and MLFQ with per-core run queues.
+ *
+ * At each event time (an arrival or the end of some core's slice):
+ *   1. slices ending now finish their process or take it off the CPU,
+ *   2. arrivals are placed on the least loaded core,
+ *   3. preempted processes are requeued on their own core, behind those arrivals
+ *      (the single-CPU RR/MLFQ order),
+ *   4. MLFQ boosts all cores if the interval has passed and some core is about
+ *      to pick (the single-CPU version checks between slices),
+ *   5. every idle core dispatches from its queue; those left idle steal from the
+ *      busiest queue.
+ * Run queues are doubly linked through prev/next arrays (a process is in at most
+ * one queue), so pushes, pops and steals from the tail are all O(1).
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "smp.h"
+#include "ready_queue.h"
+
+typedef struct {
+    int head;                   // -1 if empty
+    int tail;
+} smp_list_t;
+
+typedef struct {
+    int *next;
+    int *prev;
+} smp_links_t;
+
+static void list_push(smp_list_t *l, smp_links_t *k, int idx) {
+    k->next[idx] = -1;
+    k->prev[idx] = l->tail;
+    if (l->tail == -1) l->head = idx;
+    else k->next[l->tail] = idx;
+    l->tail = idx;
+}
+
+static int list_pop_head(smp_list_t *l, smp_links_t *k) {
+    int idx = l->head;
+    l->head = k->next[idx];
+    if (l->head == -1) l->tail = -1;
+    else k->prev[l->head] = -1;
+    return idx;
+}
+
+static int list_pop_tail(smp_list_t *l, smp_links_t *k) {
+    int idx = l->tail;
+    l->tail = k->prev[idx];
+    if (l->tail == -1) l->head = -1;
+    else k->next[l->tail] = -1;
+    return idx;
+}
+
+static void list_splice(smp_list_t *dst, smp_list_t *src, smp_links_t *k) {
+    if (src->head == -1) return;
+    if (dst->tail == -1) dst->head = src->head;
+    else {
+        k->next[dst->tail] = src->head;
+        k->prev[src->head] = dst->tail;
+    }
+    dst->tail = src->tail;
+    src->head = src->tail = -1;
+}
+
+int smp_policy_from_name(const char *name, smp_policy_t *policy) {
+    if (strcmp(name, "fifo") == 0) *policy = SMP_FIFO;
+    else if (strcmp(name, "rr") == 0) *policy = SMP_RR;
+    else if (strcmp(name, "mlfq") == 0) *policy = SMP_MLFQ;
+    else return -1;
+    return 0;
+}
+
+/* Per-run state; arrays are indexed by core unless noted. */
+typedef struct {
+    const smp_config_t *cfg;
+    process_store_t *ps;
+    timeline_sink_t *timeline;
+    smp_stats_t *stats;
+    int cores;
+    int levels;
+    int place_next;             // core where the next tie-break scan starts
+    smp_links_t links;
+    smp_list_t *queues;         // cores * levels, core-major
+    int *last_core;             // per process: core of its previous slice, -1 before the first
+    int *queued;                // processes waiting in the core's queues
+    int *load;                  // unfinished processes assigned to the core (queued + running)
+    int *running;               // process on the CPU, -1 if idle
+    int *run_level;             // queue level it was taken from (-1 after a boost: requeue at the top)
+    int *pending;               // process whose slice just ended unfinished, -1 if none
+    sim_time_t *slice_end;
+    sim_time_t *idle_since;
+} smp_state_t;
+
+static void enqueue(smp_state_t *s, int core, int level, int idx) {
+    list_push(&s->queues[core * s->levels + level], &s->links, idx);
+    s->queued[core]++;
+    SCHED_COUNT(s->ps->stats, queue_pushes, 1);
+}
+
+/* New arrival: core with the fewest unfinished processes; ties rotate so idle cores share the work. */
+static void place(smp_state_t *s, int idx) {
+    int best = s->place_next;
+    for (int k = 1; k < s->cores; ++k) {
+        int c = (s->place_next + k) % s->cores;
+        if (s->load[c] < s->load[best]) best = c;
+    }
+    s->place_next = (best + 1) % s->cores;
+    s->load[best]++;
+    enqueue(s, best, 0, idx);
+}
+
+/* Idle core with an empty queue: take the newest entry of the fullest queue's highest level. */
+static void steal(smp_state_t *s, int thief) {
+    int victim = -1;
+    for (int c = 0; c < s->cores; ++c)
+        if (c != thief && s->queued[c] > 0 && (victim == -1 || s->queued[c] > s->queued[victim])) victim = c;
+    if (victim == -1) return;
+    for (int l = 0; l < s->levels; ++l) {
+        smp_list_t *q = &s->queues[victim * s->levels + l];
+        if (q->head == -1) continue;
+        int idx = list_pop_tail(q, &s->links);
+        s->queued[victim]--;
+        s->load[victim]--;
+        s->load[thief]++;
+        enqueue(s, thief, l, idx);
+        s->stats->steals++;
+        return;
+    }
+}
+
+static void dispatch(smp_state_t *s, int core, sim_time_t time) {
+    int level = -1;
+    for (int l = 0; l < s->levels; ++l)
+        if (s->queues[core * s->levels + l].head != -1) { level = l; break; }
+    if (level == -1) return;
+    int idx = list_pop_head(&s->queues[core * s->levels + level], &s->links);
+    s->queued[core]--;
+    SCHED_COUNT(s->ps->stats, queue_pops, 1);
+    SCHED_COUNT(s->ps->stats, candidate_scans, level + 1);
+
+    process_hot_t *p = &s->ps->hot[idx];
+    process_cold_t *c = &s->ps->cold[idx];
+    if (time > s->idle_since[core]) {
+        timeline_emit_core(s->timeline, core, s->idle_since[core], -1, time - s->idle_since[core]);
+        SCHED_COUNT(s->ps->stats, idle_gaps, 1);
+    }
+    if (c->start_time == -1) c->start_time = time;
+    if (s->last_core[idx] != -1 && s->last_core[idx] != core) s->stats->migrations++;
+    s->last_core[idx] = core;
+
+    sim_time_t use = p->remaining_time;
+    if (s->cfg->policy == SMP_RR && use > s->cfg->quantum) use = s->cfg->quantum;
+    if (s->cfg->policy == SMP_MLFQ && use > s->cfg->mlfq->quantums[level]) use = s->cfg->mlfq->quantums[level];
+    timeline_emit_core(s->timeline, core, time, p->pid, use);
+    SCHED_COUNT(s->ps->stats, dispatches, 1);
+    p->remaining_time -= use;
+    s->running[core] = idx;
+    s->run_level[core] = level;
+    s->slice_end[core] = time + use;
+    s->stats->busy[core] += use;
+    s->stats->dispatches[core]++;
+}
+
+static void fill_stats(smp_stats_t *st, int cores, sim_time_t elapsed) {
+    sim_time_t total = 0, max = 0;
+    st->elapsed = elapsed;
+    for (int c = 0; c < cores; ++c) {
+        total += st->busy[c];
+        if (st->busy[c] > max) max = st->busy[c];
+        st->utilization[c] = elapsed > 0 ? (double)st->busy[c] / elapsed * 100.0 : 0.0;
+    }
+    st->aggregate_utilization = elapsed > 0 ? (double)total / ((double)elapsed * cores) * 100.0 : 0.0;
+    double mean = (double)total / cores;
+    st->imbalance = mean > 0 ? (double)max / mean - 1.0 : 0.0;
+}
+
+int schedule_smp(process_store_t *ps, const smp_config_t *config, timeline_sink_t *timeline,
+                 smp_stats_t *stats) {
+    int cores = config->num_cores;
+    if (cores < 1 || cores > SMP_MAX_CORES) {
+        fprintf(stderr, "schedule_smp: num_cores must be 1..%d\n", SMP_MAX_CORES);
+        return -1;
+    }
+    if ((config->policy == SMP_RR && config->quantum <= 0) ||
+        (config->policy == SMP_MLFQ && (!config->mlfq || config->mlfq->num_queues <= 0))) {
+        fprintf(stderr, "schedule_smp: missing quantum or MLFQ config\n");
+        return -1;
+    }
+    process_store_reset(ps);
+    memset(stats, 0, sizeof(*stats));
+    stats->num_cores = cores;
+    process_hot_t *hot = ps->hot;
+    int n = ps->n;
+    sched_stats_t *st = ps->stats;
+    long events0 = timeline->events;
+
+    smp_state_t s;
+    s.cfg = config;
+    s.ps = ps;
+    s.timeline = timeline;
+    s.stats = stats;
+    s.cores = cores;
+    s.place_next = 0;
+    s.levels = (config->policy == SMP_MLFQ) ? config->mlfq->num_queues : 1;
+    int slots = n > 0 ? n : 1;
+    s.links.next = malloc(sizeof(int) * slots);
+    s.links.prev = malloc(sizeof(int) * slots);
+    s.last_core = malloc(sizeof(int) * slots);
+    s.queues = malloc(sizeof(smp_list_t) * cores * s.levels);
+    s.queued = calloc(cores, sizeof(int));
+    s.load = calloc(cores, sizeof(int));
+    s.running = malloc(sizeof(int) * cores);
+    s.run_level = malloc(sizeof(int) * cores);
+    s.pending = malloc(sizeof(int) * cores);
+    s.slice_end = malloc(sizeof(sim_time_t) * cores);
+    s.idle_since = malloc(sizeof(sim_time_t) * cores);
+    int *order = arrival_order(hot, n);
+    int rc = -1;
+    if (!s.links.next || !s.links.prev || !s.last_core || !s.queues || !s.queued ||
+        !s.load || !s.running || !s.run_level || !s.pending || !s.slice_end || !s.idle_since || !order) {
+        perror("malloc");
+        goto out;
+    }
+
+    sim_time_t time = n > 0 ? hot[order[0]].arrival_time : 0;
+    sim_time_t start = time, last_boost = time;
+    for (int i = 0; i < n; ++i) s.last_core[i] = -1;
+    for (int q = 0; q < cores * s.levels; ++q) s.queues[q].head = s.queues[q].tail = -1;
+    for (int c = 0; c < cores; ++c) {
+        s.running[c] = s.pending[c] = -1;
+        s.idle_since[c] = time;
+    }
+    int next = 0;   // arrival cursor into order[]
+    int completed = 0;
+    while (completed < n) {
+        // 1. slices ending now
+        for (int c = 0; c < cores; ++c) {
+            int idx = s.running[c];
+            if (idx == -1 || s.slice_end[c] != time) continue;
+            s.running[c] = -1;
+            s.idle_since[c] = time;
+            if (hot[idx].remaining_time == 0) {
+                process_store_complete(ps, idx, time);
+                s.load[c]--;
+                completed++;
+            } else {
+                s.pending[c] = idx;
+            }
+        }
+        // 2. arrivals
+        while (next < n && hot[order[next]].arrival_time <= time) place(&s, order[next++]);
+        // 3. requeue preempted processes (MLFQ: demote after a full quantum)
+        for (int c = 0; c < cores; ++c) {
+            int idx = s.pending[c];
+            if (idx == -1) continue;
+            s.pending[c] = -1;
+            int level = 0;
+            if (config->policy == SMP_MLFQ) {
+                level = s.run_level[c] + 1;
+                if (level >= s.levels) level = s.levels - 1;
+                if (level > s.run_level[c] && s.run_level[c] >= 0) SCHED_COUNT(st, demotions, 1);
+            }
+            enqueue(&s, c, level, idx);
+            SCHED_COUNT(st, preemptions, 1);
+        }
+        // 4. MLFQ boost on every core
+        int any_idle = 0;
+        for (int c = 0; c < cores && !any_idle; ++c) any_idle = (s.running[c] == -1);
+        if (any_idle && config->policy == SMP_MLFQ && config->mlfq->boost_interval > 0 &&
+            time - last_boost >= config->mlfq->boost_interval) {
+            for (int c = 0; c < cores; ++c) {
+                smp_list_t *top = &s.queues[c * s.levels];
+                for (int l = 1; l < s.levels; ++l) list_splice(top, &top[l], &s.links);
+                s.run_level[c] = -1;    // processes mid-slice go back to the top too
+            }
+            last_boost = time;
+            SCHED_COUNT(st, boosts, 1);
+        }
+        // 5. idle cores run their own work first, then the still idle ones steal
+        for (int c = 0; c < cores; ++c)
+            if (s.running[c] == -1 && s.queued[c] > 0) dispatch(&s, c, time);
+        for (int c = 0; c < cores && config->steal; ++c) {
+            if (s.running[c] != -1) continue;
+            steal(&s, c);
+            if (s.queued[c] > 0) dispatch(&s, c, time);
+        }
+        // advance to the next arrival or slice end
+        sim_time_t next_time = -1;
+        if (next < n) next_time = hot[order[next]].arrival_time;
+        for (int c = 0; c < cores; ++c)
+            if (s.running[c] != -1 && (next_time == -1 || s.slice_end[c] < next_time)) next_time = s.slice_end[c];
+        if (next_time == -1) break;
+        time = next_time;
+    }
+    fill_stats(stats, cores, time - start);
+    SCHED_COUNT(st, timeline_events, timeline->events - events0);
+    timeline_flush(timeline);
+    rc = 0;
+out:
+    free(s.links.next);
+    free(s.links.prev);
+    free(s.last_core);
+    free(s.queues);
+    free(s.queued);
+    free(s.load);
+    free(s.running);
+    free(s.run_level);
+    free(s.pending);
+    free(s.slice_end);
+    free(s.idle_since);
+    free(order);
+    return rc;
+}
@@ -0,0 +1,137 @@
+/*
+ * stream.c
+ *
+ * Online (streaming) simulation. The shared engine (engine.c) runs the policy;
+ * this file is its arrival source. Processes live in a pool of reusable store
+ * slots: a slot is taken when the process arrives and handed back when it
+ * completes, so the pool only grows to the peak number of processes in the
+ * system. Arrivals come from a one-process lookahead on the reader.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "stream.h"
+#include "engine.h"
+
+typedef struct {
+    engine_source_t base;
+    // free slots of the pool
+    int *free_slots;
+    int nfree;
+    int active;
+    // arrivals: the next process from the reader, not yet admitted
+    workload_reader_t *reader;
+    process_t next;
+    int has_next;
+    int error;
+    timeline_sink_t *sink;
+    const stream_config_t *cfg;
+    stream_stats_t *stats;
+} stream_source_t;
+
+static void fetch_next(stream_source_t *c) {
+    int rc = workload_reader_next(c->reader, &c->next);
+    c->has_next = (rc == 1);
+    if (rc < 0) c->error = 1;
+}
+
+/* Double the pool; the engine then lets the policy follow (its grow hook). */
+static int grow_pool(stream_source_t *c, process_store_t *pool) {
+    int old = pool->n;
+    int cap = old ? old * 2 : 64;
+    if (process_store_reserve(pool, cap) != 0) return -1;
+    int *free_slots = realloc(c->free_slots, sizeof(int) * cap);
+    if (!free_slots) return -1;
+    c->free_slots = free_slots;
+    // push new slots so the lowest index is handed out first
+    for (int i = cap - 1; i >= old; --i) c->free_slots[c->nfree++] = i;
+    pool->n = cap;
+    return 0;
+}
+
+static sim_time_t source_peek(engine_source_t *src) {
+    const stream_source_t *c = (const stream_source_t *)src;
+    return (!c->error && c->has_next) ? c->next.arrival_time : -1;
+}
+
+/* Move the lookahead process into a free slot and read the one after it. Returns the slot or -1. */
+static int source_admit(engine_source_t *src, process_store_t *pool) {
+    stream_source_t *c = (stream_source_t *)src;
+    if (c->nfree == 0 && grow_pool(c, pool) != 0) {
+        perror("realloc");
+        c->error = 1;
+        return -1;
+    }
+    int slot = c->free_slots[--c->nfree];
+    process_hot_t *p = &pool->hot[slot];
+    p->pid = c->next.pid;
+    p->arrival_time = c->next.arrival_time;
+    p->burst_time = c->next.burst_time;
+    p->priority = c->next.priority;
+    process_store_reset_one(pool, slot);
+    if (++c->active > c->stats->peak_active) c->stats->peak_active = c->active;
+    fetch_next(c);
+    return slot;
+}
+
+/* The process in slot completed at time: stream its result and free the slot. */
+static void source_retire(engine_source_t *src, process_store_t *pool, int slot, sim_time_t time) {
+    stream_source_t *c = (stream_source_t *)src;
+    const process_hot_t *p = &pool->hot[slot];
+    const process_cold_t *r = &pool->cold[slot];
+    FILE *out = c->cfg->results;
+    if (out)
+        fprintf(out, "PID %d: arrival=%lld burst=%lld priority=%d start=%lld completion=%lld tat=%lld wt=%lld rt=%lld\n",
+                p->pid, p->arrival_time, p->burst_time, p->priority,
+                r->start_time, r->completion_time,
+                r->turnaround_time, r->waiting_time, r->response_time);
+    c->stats->retired++;
+    c->stats->end_time = time;
+    c->free_slots[c->nfree++] = slot;
+    c->active--;
+    if (out && c->cfg->metrics && c->cfg->snapshot_every > 0 && c->stats->retired % c->cfg->snapshot_every == 0) {
+        metrics_t m;
+        metrics_acc_snapshot(c->cfg->metrics, c->sink->total_time, &m);
+        fprintf(out, "Snapshot at %lld after %ld processes: avg tat=%.2f wt=%.2f rt=%.2f, "
+                "tat p50=%.0f p99=%.0f max=%.0f, cpu=%.2f%%\n",
+                time, c->stats->retired, m.avg_turnaround_time, m.avg_waiting_time, m.avg_response_time,
+                m.turnaround.p50, m.turnaround.p99, m.turnaround.max, m.cpu_utilization);
+    }
+}
+
+int stream_supports(const policy_entry_t *policy) {
+    return policy->ops->grow != NULL;
+}
+
+int run_stream(workload_reader_t *reader, const stream_config_t *config, stream_stats_t *stats) {
+    memset(stats, 0, sizeof(*stats));
+    timeline_callback_t counter;
+    timeline_callback_init(&counter, NULL, NULL);
+
+    stream_source_t c;
+    memset(&c, 0, sizeof(c));
+    c.base.peek = source_peek;
+    c.base.admit = source_admit;
+    c.base.retire = source_retire;
+    c.reader = reader;
+    c.cfg = config;
+    c.stats = stats;
+    c.sink = config->timeline ? config->timeline : &counter.base;
+
+    process_store_t pool;
+    if (process_store_init(&pool, NULL, 0) != 0) return -1;
+    pool.acc = config->metrics;
+    fetch_next(&c);
+    engine_t e;
+    if (engine_start_stream(&e, &pool, config->policy->ops, config->params, &c.base) != 0) {
+        c.error = 1;
+    } else {
+        if (engine_advance(&e, SLICE_UNLIMITED, c.sink) < 0) c.error = 1;
+        engine_free(&e);
+    }
+    stats->total_time = c.sink->total_time;
+    process_store_free(&pool);
+    free(c.free_slots);
+    return c.error ? -1 : 0;
+}
@@ -0,0 +1,184 @@
+/*
+ * sweep.c
+ *
+ * Parameter sweep engine: expands RR/MLFQ ranges into a grid of points and
+ * runs them on a fixed pool of threads that pull the next point from a
+ * shared counter. Results are written to their own slot, so output order
+ * does not depend on scheduling of the threads.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "sweep.h"
+#include "algorithms.h"
+#include "timeline.h"
+
+int parse_range(const char *text, sweep_range_t *range) {
+    if (strcmp(text, "-") == 0) {
+        range->lo = 1; range->hi = 0; range->step = 1;
+        return 0;
+    }
+    int lo, hi, step = 1;
+    int got = sscanf(text, "%d:%d:%d", &lo, &hi, &step);
+    if (got == 1) hi = lo;
+    if (got < 1 || step <= 0 || hi < lo) return -1;
+    range->lo = lo;
+    range->hi = hi;
+    range->step = step;
+    return 0;
+}
+
+static int range_count(const sweep_range_t *r) {
+    return (r->hi < r->lo) ? 0 : (r->hi - r->lo) / r->step + 1;
+}
+
+static int range_value(const sweep_range_t *r, int i) {
+    return r->lo + i * r->step;
+}
+
+typedef struct {
+    const process_t *processes;
+    int n;
+    sweep_point_t *points;
+    int count;
+    int next;                   // next point to claim
+    int failed;                 // a worker ran out of memory; its points have no results
+    pthread_mutex_t lock;
+} sweep_pool_t;
+
+static int run_point(process_store_t *store, sweep_point_t *pt) {
+    timeline_callback_t counter;
+    timeline_callback_init(&counter, NULL, NULL);
+    if (strcmp(pt->policy, "RR") == 0) {
+        schedule_rr(store, pt->quantum, &counter.base);
+    } else {
+        int *quantums = malloc(sizeof(int) * pt->num_queues);
+        if (!quantums) { perror("malloc"); return -1; }
+        // quantum doubles per level, saturating at INT_MAX instead of overflowing
+        int q = pt->quantum;
+        for (int l = 0; l < pt->num_queues; ++l) {
+            quantums[l] = q;
+            q = (q > INT_MAX / 2) ? INT_MAX : q * 2;
+        }
+        mlfq_config_t cfg = { pt->num_queues, quantums, pt->boost_interval };
+        schedule_mlfq(store, &cfg, &counter.base);
+        free(quantums);
+    }
+    metrics_acc_snapshot(store->acc, counter.base.total_time, &pt->metrics);
+    return 0;
+}
+
+static void mark_failed(sweep_pool_t *pool) {
+    pthread_mutex_lock(&pool->lock);
+    pool->failed = 1;
+    pthread_mutex_unlock(&pool->lock);
+}
+
+static void *sweep_worker(void *arg) {
+    sweep_pool_t *pool = arg;
+    // one store and accumulator per worker; every schedule_* call resets both before running
+    process_store_t store;
+    metrics_acc_t acc;
+    if (process_store_init(&store, pool->processes, pool->n) != 0) { mark_failed(pool); return NULL; }
+    if (metrics_acc_init(&acc) != 0) { process_store_free(&store); mark_failed(pool); return NULL; }
+    store.acc = &acc;
+    for (;;) {
+        pthread_mutex_lock(&pool->lock);
+        int i = pool->failed ? pool->count : pool->next++;
+        pthread_mutex_unlock(&pool->lock);
+        if (i >= pool->count) break;
+        if (run_point(&store, &pool->points[i]) != 0) mark_failed(pool);
+    }
+    metrics_acc_free(&acc);
+    process_store_free(&store);
+    return NULL;
+}
+
+int run_sweep(const process_t *processes, int n, const sweep_config_t *config, sweep_point_t **out_points) {
+    int rr = range_count(&config->rr_quantum);
+    int mlfq = range_count(&config->mlfq_queues) * range_count(&config->mlfq_base_quantum) *
+               range_count(&config->mlfq_boost);
+    int count = rr + mlfq;
+    sweep_point_t *points = calloc(count > 0 ? count : 1, sizeof(sweep_point_t));
+    if (!points) { perror("calloc"); return -1; }
+
+    // expand the grid: RR points first, then MLFQ by (queues, base quantum, boost)
+    int k = 0;
+    for (int i = 0; i < rr; ++i) {
+        points[k].policy = "RR";
+        points[k].quantum = range_value(&config->rr_quantum, i);
+        k++;
+    }
+    for (int a = 0; a < range_count(&config->mlfq_queues); ++a)
+        for (int b = 0; b < range_count(&config->mlfq_base_quantum); ++b)
+            for (int c = 0; c < range_count(&config->mlfq_boost); ++c) {
+                points[k].policy = "MLFQ";
+                points[k].num_queues = range_value(&config->mlfq_queues, a);
+                points[k].quantum = range_value(&config->mlfq_base_quantum, b);
+                points[k].boost_interval = range_value(&config->mlfq_boost, c);
+                k++;
+            }
+
+    sweep_pool_t pool;
+    pool.processes = processes;
+    pool.n = n;
+    pool.points = points;
+    pool.count = count;
+    pool.next = 0;
+    pool.failed = 0;
+    pthread_mutex_init(&pool.lock, NULL);
+
+    int threads = config->threads;
+    if (threads <= 0) threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    if (threads <= 0) threads = 1;
+    if (threads > count) threads = count;
+    pthread_t *tids = malloc(sizeof(pthread_t) * (threads > 0 ? threads : 1));
+    int started = 0;
+    for (int t = 0; tids && t < threads; ++t) {
+        if (pthread_create(&tids[t], NULL, sweep_worker, &pool) != 0) break;
+        started++;
+    }
+    if (started == 0) sweep_worker(&pool);  // no threads available, run inline
+    for (int t = 0; t < started; ++t) pthread_join(tids[t], NULL);
+    free(tids);
+    pthread_mutex_destroy(&pool.lock);
+    if (pool.failed) { free(points); return -1; }
+
+    *out_points = points;
+    return count;
+}
+
+int write_sweep(const char *path, const sweep_point_t *points, int count) {
+    FILE *f = fopen(path, "w");
+    if (!f) { perror("fopen"); return -1; }
+    size_t len = strlen(path);
+    int markdown = (len >= 3 && strcmp(path + len - 3, ".md") == 0);
+
+    if (markdown) {
+        fprintf(f, "# Parameter Sweep\n\n");
+        fprintf(f, "| Policy | Quantum | Queues | Boost | Avg TAT | Avg WT | Avg RT | CPU %% | Throughput | Fairness |\n");
+        fprintf(f, "|--------|---------|--------|-------|---------|--------|--------|-------|------------|----------|\n");
+    } else {
+        fprintf(f, "policy,quantum,num_queues,boost_interval,avg_turnaround,avg_waiting,avg_response,cpu_utilization,throughput,fairness\n");
+    }
+    for (int i = 0; i < count; ++i) {
+        const sweep_point_t *p = &points[i];
+        const metrics_t *m = &p->metrics;
+        if (markdown)
+            fprintf(f, "| %s | %d | %d | %d | %.2f | %.2f | %.2f | %.2f | %.4f | %.4f |\n",
+                    p->policy, p->quantum, p->num_queues, p->boost_interval,
+                    m->avg_turnaround_time, m->avg_waiting_time, m->avg_response_time,
+                    m->cpu_utilization, m->throughput, m->fairness_index);
+        else
+            fprintf(f, "%s,%d,%d,%d,%.4f,%.4f,%.4f,%.4f,%.6f,%.6f\n",
+                    p->policy, p->quantum, p->num_queues, p->boost_interval,
+                    m->avg_turnaround_time, m->avg_waiting_time, m->avg_response_time,
+                    m->cpu_utilization, m->throughput, m->fairness_index);
+    }
+    fclose(f);
+    return 0;
+}
@@ -0,0 +1,140 @@
+/*
+ * timeline.c
+ *
+ * Timeline sinks: growable buffer, callback, FILE stream and run-length
+ * coalescing wrapper.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include "timeline.h"
+
+void timeline_flush(timeline_sink_t *sink) {
+    if (sink->flush) sink->flush(sink);
+}
+
+/* ---- growable buffer ---- */
+
+static void buffer_emit(timeline_sink_t *self, const timeline_event_t *ev) {
+    timeline_buffer_t *buf = (timeline_buffer_t *)self;
+    if (self->error) return;
+    if (buf->len >= buf->cap) {
+        if (buf->cap > SIZE_MAX / 2 / sizeof(timeline_event_t)) {
+            fprintf(stderr, "timeline: too many events\n");
+            self->error = 1;
+            return;
+        }
+        size_t cap = buf->cap ? buf->cap * 2 : 64;
+        timeline_event_t *grown = realloc(buf->events, sizeof(timeline_event_t) * cap);
+        if (!grown) { perror("realloc"); self->error = 1; return; }
+        buf->events = grown;
+        buf->cap = cap;
+    }
+    buf->events[buf->len++] = *ev;
+}
+
+void timeline_buffer_init(timeline_buffer_t *buf) {
+    buf->base.emit = buffer_emit;
+    buf->base.flush = NULL;
+    buf->base.events = 0;
+    buf->base.total_time = 0;
+    buf->base.error = 0;
+    buf->events = NULL;
+    buf->len = buf->cap = 0;
+}
+
+void timeline_buffer_reset(timeline_buffer_t *buf) {
+    buf->base.events = 0;
+    buf->base.total_time = 0;
+    buf->base.error = 0;
+    buf->len = 0;
+}
+
+void timeline_buffer_free(timeline_buffer_t *buf) {
+    free(buf->events);
+    buf->events = NULL;
+    buf->len = buf->cap = 0;
+}
+
+/* ---- callback ---- */
+
+static void callback_emit(timeline_sink_t *self, const timeline_event_t *ev) {
+    timeline_callback_t *cb = (timeline_callback_t *)self;
+    if (cb->fn) cb->fn(ev, cb->ctx);
+}
+
+void timeline_callback_init(timeline_callback_t *cb, timeline_callback_fn fn, void *ctx) {
+    cb->base.emit = callback_emit;
+    cb->base.flush = NULL;
+    cb->base.events = 0;
+    cb->base.total_time = 0;
+    cb->base.error = 0;
+    cb->fn = fn;
+    cb->ctx = ctx;
+}
+
+/* ---- FILE stream ---- */
+
+static void stream_emit(timeline_sink_t *self, const timeline_event_t *ev) {
+    timeline_stream_t *stream = (timeline_stream_t *)self;
+    fprintf(stream->out, "  time=%lld pid=%d dur=%lld\n", ev->time, ev->pid, ev->duration);
+}
+
+static void stream_flush(timeline_sink_t *self) {
+    fflush(((timeline_stream_t *)self)->out);
+}
+
+void timeline_stream_init(timeline_stream_t *stream, FILE *out) {
+    stream->base.emit = stream_emit;
+    stream->base.flush = stream_flush;
+    stream->base.events = 0;
+    stream->base.total_time = 0;
+    stream->base.error = 0;
+    stream->out = out;
+}
+
+/* ---- run-length coalescing ---- */
+
+static void coalesce_emit(timeline_sink_t *self, const timeline_event_t *ev) {
+    timeline_coalesce_t *co = (timeline_coalesce_t *)self;
+    if (co->has_pending && co->pending.pid == ev->pid && co->pending.core == ev->core &&
+        co->pending.time + co->pending.duration == ev->time) {
+        co->pending.duration += ev->duration;
+        return;
+    }
+    if (co->has_pending)
+        timeline_emit_core(co->downstream, co->pending.core, co->pending.time, co->pending.pid,
+                           co->pending.duration);
+    self->error = co->downstream->error;
+    co->pending = *ev;
+    co->has_pending = 1;
+}
+
+static void coalesce_flush(timeline_sink_t *self) {
+    timeline_coalesce_t *co = (timeline_coalesce_t *)self;
+    if (co->has_pending) {
+        timeline_emit_core(co->downstream, co->pending.core, co->pending.time, co->pending.pid,
+                           co->pending.duration);
+        co->has_pending = 0;
+    }
+    self->error = co->downstream->error;
+    timeline_flush(co->downstream);
+}
+
+void timeline_coalesce_init(timeline_coalesce_t *co, timeline_sink_t *downstream) {
+    co->base.emit = coalesce_emit;
+    co->base.flush = coalesce_flush;
+    co->base.events = 0;
+    co->base.total_time = 0;
+    co->base.error = 0;
+    co->downstream = downstream;
+    co->has_pending = 0;
+}
+
+/* compute total_time from timeline */
+sim_time_t compute_total_time(timeline_event_t *timeline, size_t tlen) {
+    sim_time_t total = 0;
+    for (size_t i = 0; i < tlen; ++i) total += timeline[i].duration;
+    return total;
+}
@@ -0,0 +1,395 @@
+/*
+ * workload.c
+ *
+ * Reading and writing workload files: the text format ("arrival burst priority"
+ * per line) and the packed binary format. Both are read through mmap; large
+ * text files are split into line-aligned chunks parsed on separate threads.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <pthread.h>
+#include "workload.h"
+
+static const char workload_bin_magic[8] = WORKLOAD_BIN_MAGIC;
+
+/* ---- text format: chunked parallel parser ---- */
+
+#define MAX_CHUNK_ERRORS     8          // errors remembered per chunk
+#define MIN_PARALLEL_BYTES   (1 << 20)  // smaller files are parsed on one thread
+
+typedef struct {
+    const char *begin;          // chunk covers whole lines [begin, end)
+    const char *end;
+    workload_record_t *records;
+    int count;
+    int cap;
+    int lines;                  // lines in this chunk
+    int nerrors;
+    int error_line[MAX_CHUNK_ERRORS];   // chunk-relative, 1-based
+    const char *error_msg[MAX_CHUNK_ERRORS];
+} parse_chunk_t;
+
+static int is_blank(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+/* Parse one decimal int at *pp, advancing past it. Returns 0 on success. */
+static int parse_int(const char **pp, const char *end, int *out) {
+    const char *p = *pp;
+    int neg = 0;
+    if (p < end && (*p == '-' || *p == '+')) { neg = (*p == '-'); p++; }
+    if (p >= end || *p < '0' || *p > '9') return -1;
+    long long v = 0;
+    while (p < end && *p >= '0' && *p <= '9') {
+        v = v * 10 + (*p - '0');
+        if (v > 2147483648LL) return -1;
+        p++;
+    }
+    if (neg) v = -v;
+    if (v > 2147483647LL) return -1;
+    *out = (int)v;
+    *pp = p;
+    return 0;
+}
+
+static void chunk_error(parse_chunk_t *c, const char *msg) {
+    if (c->nerrors < MAX_CHUNK_ERRORS) {
+        c->error_line[c->nerrors] = c->lines;
+        c->error_msg[c->nerrors] = msg;
+    }
+    c->nerrors++;
+}
+
+/* Field checks shared by the text and binary formats; returns the error, or NULL if the record is valid. */
+static const char *check_record(long long arrival, long long burst) {
+    if (arrival < 0) return "arrival must be >= 0";
+    if (burst <= 0) return "burst must be > 0";
+    return NULL;
+}
+
+/*
+ * Parse one line [p, eol) into v[3]. Returns 1 for a record, 0 for a blank or
+ * '#' comment line, -1 on error with *err set.
+ */
+static int parse_record(const char *p, const char *eol, int v[3], const char **err) {
+    while (p < eol && is_blank(*p)) p++;
+    if (p == eol || *p == '#') return 0;
+    for (int k = 0; k < 3; ++k) {
+        if (k > 0) {
+            if (p == eol || !is_blank(*p)) { *err = "expected 'arrival burst priority'"; return -1; }
+            while (p < eol && is_blank(*p)) p++;
+        }
+        if (parse_int(&p, eol, &v[k]) != 0) { *err = "expected 'arrival burst priority'"; return -1; }
+    }
+    while (p < eol && is_blank(*p)) p++;
+    if (p != eol) { *err = "unexpected text after priority"; return -1; }
+    *err = check_record(v[0], v[1]);
+    return *err ? -1 : 1;
+}
+
+static void parse_line(parse_chunk_t *c, const char *p, const char *eol) {
+    int v[3];
+    const char *err = NULL;
+    int rc = parse_record(p, eol, v, &err);
+    if (rc < 0) { chunk_error(c, err); return; }
+    if (rc == 0) return;
+    if (c->count == c->cap) {
+        int cap = c->cap ? c->cap * 2 : 1024;
+        workload_record_t *grown = realloc(c->records, sizeof(workload_record_t) * cap);
+        if (!grown) { chunk_error(c, "out of memory"); return; }
+        c->records = grown;
+        c->cap = cap;
+    }
+    workload_record_t *r = &c->records[c->count++];
+    r->arrival = v[0];
+    r->burst = v[1];
+    r->priority = v[2];
+}
+
+static void *parse_chunk(void *arg) {
+    parse_chunk_t *c = arg;
+    const char *p = c->begin;
+    while (p < c->end) {
+        const char *eol = memchr(p, '\n', (size_t)(c->end - p));
+        if (!eol) eol = c->end;
+        c->lines++;
+        parse_line(c, p, eol);
+        p = eol + 1;
+    }
+    return NULL;
+}
+
+static int parse_workload_text(const char *path, const char *data, size_t size, process_t **out_processes) {
+    int threads = 1;
+    if (size >= MIN_PARALLEL_BYTES) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = (cpus > 1) ? (int)cpus : 1;
+        if ((size_t)threads > size / (MIN_PARALLEL_BYTES / 4)) threads = (int)(size / (MIN_PARALLEL_BYTES / 4));
+        if (threads < 1) threads = 1;
+    }
+    parse_chunk_t *chunks = calloc(threads, sizeof(parse_chunk_t));
+    pthread_t *tids = malloc(sizeof(pthread_t) * threads);
+    int *started = calloc(threads, sizeof(int));
+    if (!chunks || !tids || !started) { perror("malloc"); free(chunks); free(tids); free(started); return -1; }
+
+    // split into roughly equal chunks, moving each boundary to just after a newline
+    const char *end = data + size;
+    const char *cursor = data;
+    for (int t = 0; t < threads; ++t) {
+        const char *stop = (t == threads - 1) ? end : data + size / threads * (t + 1);
+        if (stop < cursor) stop = cursor;
+        if (stop < end) {
+            const char *nl = memchr(stop, '\n', (size_t)(end - stop));
+            stop = nl ? nl + 1 : end;
+        }
+        chunks[t].begin = cursor;
+        chunks[t].end = stop;
+        cursor = stop;
+    }
+    for (int t = 1; t < threads; ++t)
+        started[t] = (pthread_create(&tids[t], NULL, parse_chunk, &chunks[t]) == 0);
+    parse_chunk(&chunks[0]);
+    for (int t = 1; t < threads; ++t) {
+        if (started[t]) pthread_join(tids[t], NULL);
+        else parse_chunk(&chunks[t]);  // no thread available, run inline
+    }
+
+    // report errors with file line numbers, then stitch records together in file order
+    int total = 0, errors = 0, line_base = 0;
+    for (int t = 0; t < threads; ++t) {
+        for (int e = 0; e < chunks[t].nerrors && e < MAX_CHUNK_ERRORS; ++e)
+            fprintf(stderr, "%s:%d: %s\n", path, line_base + chunks[t].error_line[e], chunks[t].error_msg[e]);
+        if (chunks[t].nerrors > MAX_CHUNK_ERRORS)
+            fprintf(stderr, "%s: %d more errors near line %d\n", path,
+                    chunks[t].nerrors - MAX_CHUNK_ERRORS, line_base + chunks[t].lines);
+        errors += chunks[t].nerrors;
+        line_base += chunks[t].lines;
+        total += chunks[t].count;
+    }
+    process_t *list = NULL;
+    if (errors == 0) {
+        list = malloc(sizeof(process_t) * (total > 0 ? total : 1));
+        if (!list) perror("malloc");
+    }
+    int k = 0;
+    for (int t = 0; t < threads; ++t) {
+        for (int i = 0; list && i < chunks[t].count; ++i, ++k) {
+            list[k].pid = k + 1;
+            list[k].arrival_time = chunks[t].records[i].arrival;
+            list[k].burst_time = chunks[t].records[i].burst;
+            list[k].priority = chunks[t].records[i].priority;
+        }
+        free(chunks[t].records);
+    }
+    free(chunks); free(tids); free(started);
+    if (!list) return -1;
+    *out_processes = list;
+    return total;
+}
+
+/* ---- binary format ---- */
+
+/* Check the header of a binary workload mapped at base and fill map in; unmaps base on error. */
+static int map_attach(const char *path, void *base, size_t size, workload_map_t *map) {
+    const workload_bin_header_t *h = base;
+    if (size < sizeof(*h) ||
+        memcmp(h->magic, workload_bin_magic, sizeof(h->magic)) != 0 ||
+        h->version != WORKLOAD_BIN_VERSION ||
+        h->record_size != sizeof(workload_record_t) ||
+        h->count > (uint64_t)((size - sizeof(*h)) / sizeof(workload_record_t)) ||
+        h->count > (uint64_t)INT32_MAX) {
+        fprintf(stderr, "%s: bad or truncated binary workload header\n", path);
+        munmap(base, size);
+        return -1;
+    }
+    madvise(base, size, MADV_SEQUENTIAL);
+    map->base = base;
+    map->size = size;
+    map->records = (const workload_record_t *)((const char *)base + sizeof(*h));
+    map->count = (int)h->count;
+    return 0;
+}
+
+/*
+ * Validate the records of map and copy them into a process array. The copy is
+ * deliberate: callers keep process_t arrays for output and reports, and the
+ * process store widens the int32 fields to sim_time_t anyway.
+ */
+static int expand_map(const char *path, const workload_map_t *map, process_t **out_processes) {
+    process_t *list = malloc(sizeof(process_t) * (map->count > 0 ? map->count : 1));
+    if (!list) { perror("malloc"); return -1; }
+    for (int i = 0; i < map->count; ++i) {
+        const workload_record_t *r = &map->records[i];
+        const char *err = check_record(r->arrival, r->burst);
+        if (err) {
+            fprintf(stderr, "%s: record %d: %s\n", path, i, err);
+            free(list);
+            return -1;
+        }
+        list[i].pid = i + 1;
+        list[i].arrival_time = r->arrival;
+        list[i].burst_time = r->burst;
+        list[i].priority = r->priority;
+    }
+    *out_processes = list;
+    return map->count;
+}
+
+/* read workload file; format: lines with "arrival burst priority" (binary files are detected by magic) */
+int load_workload(const char *path, process_t **out_processes) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) { perror("open"); return -1; }
+    struct stat st;
+    if (fstat(fd, &st) != 0) { perror("fstat"); close(fd); return -1; }
+    size_t size = (size_t)st.st_size;
+    if (size == 0) {
+        close(fd);
+        *out_processes = malloc(sizeof(process_t));
+        return 0;
+    }
+    void *data = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) { perror("mmap"); return -1; }
+    if (size >= sizeof(workload_bin_magic) && memcmp(data, workload_bin_magic, sizeof(workload_bin_magic)) == 0) {
+        // binary: validate and expand the mapping we already have
+        workload_map_t map;
+        if (map_attach(path, data, size, &map) != 0) return -1;
+        int count = expand_map(path, &map, out_processes);
+        workload_map_close(&map);
+        return count;
+    }
+    madvise(data, size, MADV_SEQUENTIAL);
+    int count = parse_workload_text(path, data, size, out_processes);
+    munmap(data, size);
+    return count;
+}
+
+/* ---- streaming reader ---- */
+
+int workload_reader_open(workload_reader_t *reader, const char *path) {
+    reader->path = path;
+    if (strcmp(path, "-") == 0) {
+        reader->f = stdin;
+        reader->path = "<stdin>";
+    } else {
+        reader->f = fopen(path, "r");
+        if (!reader->f) { perror("fopen"); return -1; }
+    }
+    reader->line = NULL;
+    reader->line_cap = 0;
+    reader->lineno = 0;
+    reader->last_arrival = 0;
+    reader->next_pid = 1;
+    return 0;
+}
+
+int workload_reader_next(workload_reader_t *reader, process_t *out) {
+    ssize_t len;
+    while ((len = getline(&reader->line, &reader->line_cap, reader->f)) >= 0) {
+        reader->lineno++;
+        const char *eol = reader->line + len;
+        if (len > 0 && eol[-1] == '\n') eol--;
+        int v[3];
+        const char *err = NULL;
+        int rc = parse_record(reader->line, eol, v, &err);
+        if (rc == 0) continue;
+        if (rc > 0 && v[0] < reader->last_arrival) {
+            rc = -1;
+            err = "arrival out of order (streamed input must be sorted by arrival)";
+        }
+        if (rc < 0) {
+            fprintf(stderr, "%s:%d: %s\n", reader->path, reader->lineno, err);
+            return -1;
+        }
+        reader->last_arrival = v[0];
+        out->pid = reader->next_pid++;
+        out->arrival_time = v[0];
+        out->burst_time = v[1];
+        out->priority = v[2];
+        return 1;
+    }
+    if (ferror(reader->f)) { perror("getline"); return -1; }
+    return 0;
+}
+
+void workload_reader_close(workload_reader_t *reader) {
+    if (reader->f && reader->f != stdin) fclose(reader->f);
+    reader->f = NULL;
+    free(reader->line);
+    reader->line = NULL;
+}
+
+int write_workload(const char *path, const process_t *processes, int n) {
+    FILE *f = fopen(path, "w");
+    if (!f) { perror("fopen"); return -1; }
+    fprintf(f, "# arrival burst priority\n");
+    for (int i = 0; i < n; ++i)
+        fprintf(f, "%lld %lld %d\n", processes[i].arrival_time, processes[i].burst_time, processes[i].priority);
+    if (fclose(f) != 0) { perror("fclose"); return -1; }
+    return 0;
+}
+
+int workload_map_open(const char *path, workload_map_t *map) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) { perror("open"); return -1; }
+    struct stat st;
+    if (fstat(fd, &st) != 0) { perror("fstat"); close(fd); return -1; }
+    size_t size = (size_t)st.st_size;
+    if (size < sizeof(workload_bin_header_t)) {
+        fprintf(stderr, "%s: too small for a binary workload\n", path);
+        close(fd);
+        return -1;
+    }
+    void *base = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);  // the mapping keeps the file referenced
+    if (base == MAP_FAILED) { perror("mmap"); return -1; }
+    return map_attach(path, base, size, map);
+}
+
+void workload_map_close(workload_map_t *map) {
+    if (map->base) munmap(map->base, map->size);
+    map->base = NULL;
+    map->records = NULL;
+    map->size = 0;
+    map->count = 0;
+}
+
+int load_workload_bin(const char *path, process_t **out_processes) {
+    workload_map_t map;
+    if (workload_map_open(path, &map) != 0) return -1;
+    int count = expand_map(path, &map, out_processes);
+    workload_map_close(&map);
+    return count;
+}
+
+int write_workload_bin(const char *path, const process_t *processes, int n) {
+    FILE *f = fopen(path, "wb");
+    if (!f) { perror("fopen"); return -1; }
+    workload_bin_header_t h;
+    memset(&h, 0, sizeof(h));
+    memcpy(h.magic, workload_bin_magic, sizeof(h.magic));
+    h.version = WORKLOAD_BIN_VERSION;
+    h.record_size = sizeof(workload_record_t);
+    h.count = (uint64_t)n;
+    int ok = fwrite(&h, sizeof(h), 1, f) == 1;
+    // write records in blocks to keep the number of stdio calls low
+    workload_record_t block[4096];
+    for (int i = 0; ok && i < n; i += 4096) {
+        int len = (n - i < 4096) ? n - i : 4096;
+        for (int k = 0; k < len; ++k) {
+            block[k].arrival = processes[i + k].arrival_time;
+            block[k].burst = processes[i + k].burst_time;
+            block[k].priority = processes[i + k].priority;
+        }
+        ok = fwrite(block, sizeof(workload_record_t), len, f) == (size_t)len;
+    }
+    if (fclose(f) != 0) ok = 0;
+    if (!ok) { perror("write"); return -1; }
+    return 0;
+}
@@ -0,0 +1,147 @@
+/*
+ * workload_gen.c
+ *
+ * Synthetic workload generator: Poisson or bursty arrivals, exponential,
+ * bimodal or Pareto bursts, and weighted priority mixes.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <limits.h>
+#include "workload_gen.h"
+
+static uint64_t splitmix64(uint64_t *x) {
+    uint64_t z = (*x += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+static uint64_t rotl(uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+}
+
+void gen_rng_seed(gen_rng_t *rng, uint64_t seed) {
+    for (int i = 0; i < 4; ++i) rng->s[i] = splitmix64(&seed);
+}
+
+uint64_t gen_rng_next(gen_rng_t *rng) {
+    uint64_t *s = rng->s;
+    uint64_t result = rotl(s[1] * 5, 7) * 9;
+    uint64_t t = s[1] << 17;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rotl(s[3], 45);
+    return result;
+}
+
+double gen_rng_uniform(gen_rng_t *rng) {
+    // 53 random bits, shifted off zero so log() is always finite
+    return ((double)(gen_rng_next(rng) >> 11) + 0.5) * (1.0 / 9007199254740992.0);
+}
+
+static double exponential(gen_rng_t *rng, double mean) {
+    return -mean * log(gen_rng_uniform(rng));
+}
+
+void workload_gen_defaults(workload_gen_config_t *config) {
+    config->count = 1000;
+    config->seed = 1;
+    config->arrival = ARRIVAL_POISSON;
+    config->arrival_rate = 0.5;
+    config->batch_mean = 8.0;
+    config->burst = BURST_EXPONENTIAL;
+    config->burst_mean = 10.0;
+    config->burst_long_mean = 200.0;
+    config->long_fraction = 0.1;
+    config->pareto_alpha = 1.5;
+    config->max_burst = 1000000;
+    config->num_priorities = 3;
+    config->priority_weights = NULL;
+}
+
+static int draw_burst(gen_rng_t *rng, const workload_gen_config_t *c) {
+    double b;
+    switch (c->burst) {
+        case BURST_BIMODAL:
+            b = exponential(rng, gen_rng_uniform(rng) < c->long_fraction ? c->burst_long_mean : c->burst_mean);
+            break;
+        case BURST_PARETO: {
+            // scale chosen so the distribution mean is burst_mean
+            double xm = c->burst_mean * (c->pareto_alpha - 1.0) / c->pareto_alpha;
+            b = xm / pow(gen_rng_uniform(rng), 1.0 / c->pareto_alpha);
+            break;
+        }
+        case BURST_EXPONENTIAL:
+        default:
+            b = exponential(rng, c->burst_mean);
+            break;
+    }
+    double limit = (c->max_burst > 0) ? c->max_burst : INT_MAX;
+    if (b > limit) b = limit;
+    int burst = (int)ceil(b);
+    return burst < 1 ? 1 : burst;
+}
+
+static int draw_priority(gen_rng_t *rng, const workload_gen_config_t *c, double weight_total) {
+    if (c->num_priorities <= 1) return 1;
+    if (!c->priority_weights)
+        return 1 + (int)(gen_rng_uniform(rng) * c->num_priorities);
+    double u = gen_rng_uniform(rng) * weight_total;
+    for (int p = 0; p < c->num_priorities; ++p) {
+        u -= c->priority_weights[p];
+        if (u < 0) return p + 1;
+    }
+    return c->num_priorities;
+}
+
+int generate_workload(const workload_gen_config_t *config, process_t **out_processes) {
+    const workload_gen_config_t *c = config;
+    if (c->count <= 0 || c->arrival_rate <= 0 || c->burst_mean <= 0) {
+        fprintf(stderr, "generate_workload: count, arrival_rate and burst_mean must be > 0\n");
+        return -1;
+    }
+    if (c->burst == BURST_PARETO && c->pareto_alpha <= 1.0) {
+        fprintf(stderr, "generate_workload: pareto_alpha must be > 1\n");
+        return -1;
+    }
+    double weight_total = 0.0;
+    if (c->priority_weights) {
+        for (int p = 0; p < c->num_priorities; ++p) weight_total += c->priority_weights[p];
+        if (weight_total <= 0.0) { fprintf(stderr, "generate_workload: priority weights sum to 0\n"); return -1; }
+    }
+
+    process_t *list = malloc(sizeof(process_t) * c->count);
+    if (!list) { perror("malloc"); return -1; }
+    gen_rng_t rng;
+    gen_rng_seed(&rng, c->seed);
+
+    double t = 0.0;
+    int batch_left = 0;
+    for (int i = 0; i < c->count; ++i) {
+        if (c->arrival == ARRIVAL_BURSTY) {
+            if (batch_left == 0) {
+                // batches arrive at rate / batch_mean so the overall rate is unchanged
+                t += exponential(&rng, c->batch_mean / c->arrival_rate);
+                // geometric batch size on {1, 2, ...} with mean batch_mean
+                batch_left = 1;
+                if (c->batch_mean > 1.0)
+                    batch_left += (int)floor(log(gen_rng_uniform(&rng)) / log1p(-1.0 / c->batch_mean));
+            }
+            batch_left--;
+        } else {
+            t += exponential(&rng, 1.0 / c->arrival_rate);
+        }
+        if (t > INT_MAX) t = INT_MAX;
+        list[i].pid = i + 1;
+        list[i].arrival_time = (int)t;
+        list[i].burst_time = draw_burst(&rng, c);
+        list[i].priority = draw_priority(&rng, c, weight_total);
+    }
+    *out_processes = list;
+    return c->count;
+}
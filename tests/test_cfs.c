@@ -0,0 +1,57 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../include/scheduler.h"
+#include "../include/algorithms.h"
+#include "../include/ready_queue.h"
+#include "../include/timeline.h"
+
+int main() {
+    // P1 (nice 0, weight 1024) and P2 (nice 3, weight 526) share the CPU; P3 wakes up at 50
+    process_t processes[3] = {
+        {1,0,100,1,100,0,0,0,0},
+        {2,0,100,4,100,0,0,0,0},
+        {3,50,5,1,5,0,0,0,0}
+    };
+    int n = 3;
+    int ok = 1;
+    process_store_t store;
+    process_store_init(&store, processes, n);
+    timeline_callback_t counter;
+
+    // P1 gets ~2/3 of the CPU, so it ends near 100 + 100 * 526 / 1024 + 5
+    cfs_config_t cfg = {24, 3};
+    timeline_callback_init(&counter, NULL, NULL);
+    schedule_cfs(&store, &cfg, &counter.base);
+    sim_time_t p1 = store.cold[0].completion_time;
+    if (p1 < 145 || p1 > 165) ok = 0;
+    if (store.cold[1].completion_time != 205) ok = 0;
+    // the newcomer starts at min_vruntime and runs within one period
+    if (store.cold[2].start_time < 50 || store.cold[2].start_time > 50 + 24) ok = 0;
+
+    // tree order: (key, index), leftmost cached through removals
+    long long key[6] = {5, 3, 9, 3, 1, 7};
+    rb_tree_t tree;
+    rbt_init(&tree, 6, key);
+    for (int i = 0; i < 6; ++i) rbt_insert(&tree, i);
+    rbt_remove(&tree, 2);
+    int expected[5] = {4, 1, 3, 0, 5};
+    for (int i = 0; i < 5; ++i) {
+        int idx = rbt_first(&tree);
+        if (idx != expected[i]) ok = 0;
+        rbt_remove(&tree, idx);
+    }
+    if (!rbt_empty(&tree) || rbt_first(&tree) != -1) ok = 0;
+    rbt_free(&tree);
+
+    printf("CFS test:\n");
+    printf("P1=%lld P2=%lld P3 start=%lld\n", store.cold[0].completion_time, store.cold[1].completion_time,
+           store.cold[2].start_time);
+    if (ok)
+        printf("PASSED\n");
+    else
+        printf("FAILED\n");
+
+    process_store_free(&store);
+    return 0;
+}
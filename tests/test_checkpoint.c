@@ -0,0 +1,105 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../include/scheduler.h"
+#include "../include/engine.h"
+#include "../include/policy.h"
+#include "../include/timeline.h"
+#include "../include/workload_gen.h"
+
+static int same_events(const timeline_event_t *a, const timeline_event_t *b, int len) {
+    for (int i = 0; i < len; ++i)
+        if (a[i].time != b[i].time || a[i].pid != b[i].pid || a[i].duration != b[i].duration) return 0;
+    return 1;
+}
+
+static int same_results(const process_cold_t *a, const process_cold_t *b, int n) {
+    for (int i = 0; i < n; ++i)
+        if (a[i].start_time != b[i].start_time || a[i].completion_time != b[i].completion_time ||
+            a[i].finished != b[i].finished) return 0;
+    return 1;
+}
+
+/* run ps under entry's report params, pausing at until to checkpoint into f and resuming from it */
+static int split_run(process_store_t *ps, const policy_entry_t *entry, sim_time_t until, FILE *f,
+                     timeline_buffer_t *prefix, timeline_buffer_t *suffix) {
+    engine_t e;
+    if (engine_start(&e, ps, entry->ops, &entry->report) != 0) return -1;
+    engine_advance(&e, until, &prefix->base);
+    rewind(f);
+    int rc = engine_checkpoint(&e, &prefix->base, f);
+    engine_free(&e);
+    if (rc != 0) return -1;
+    rewind(f);
+    if (engine_resume(&e, ps, entry->ops, &entry->report, &suffix->base, f) != 0) return -1;
+    engine_advance(&e, SLICE_UNLIMITED, &suffix->base);
+    engine_free(&e);
+    return 0;
+}
+
+int main() {
+    workload_gen_config_t cfg;
+    workload_gen_defaults(&cfg);
+    cfg.count = 400;
+    cfg.seed = 5;
+    process_t *processes = NULL;
+    int n = generate_workload(&cfg, &processes);
+    process_store_t ps;
+    int ok = n == 400 && process_store_init(&ps, processes, n) == 0;
+    FILE *f = tmpfile();
+    if (!f) ok = 0;
+
+    // every policy: prefix + resumed suffix must replay the uninterrupted run event for event
+    for (int slot = 0; ok && slot < POLICY_COUNT; ++slot) {
+        const policy_entry_t *entry = policy_get(slot);
+        timeline_buffer_t full, prefix, suffix;
+        timeline_buffer_init(&full);
+        timeline_buffer_init(&prefix);
+        timeline_buffer_init(&suffix);
+        engine_run(&ps, entry->ops, &entry->report, &full.base);
+        process_cold_t *expect = malloc(sizeof(process_cold_t) * n);
+        memcpy(expect, ps.cold, sizeof(process_cold_t) * n);
+        sim_time_t until = full.events[0].time + full.base.total_time / 3;
+        if (split_run(&ps, entry, until, f, &prefix, &suffix) != 0 ||
+            prefix.len == 0 || suffix.len == 0 || prefix.len + suffix.len != full.len ||
+            suffix.base.events != full.base.events || suffix.base.total_time != full.base.total_time ||
+            !same_events(prefix.events, full.events, prefix.len) ||
+            !same_events(suffix.events, full.events + prefix.len, suffix.len) ||
+            !same_results(ps.cold, expect, n)) {
+            printf("%s: resumed run differs\n", entry->name);
+            ok = 0;
+        }
+        free(expect);
+        timeline_buffer_free(&full);
+        timeline_buffer_free(&prefix);
+        timeline_buffer_free(&suffix);
+    }
+
+    // the last checkpoint (cfs) must be refused under another policy or once damaged
+    engine_t e;
+    timeline_buffer_t sink;
+    timeline_buffer_init(&sink);
+    const policy_entry_t *cfs = policy_get(policy_find("cfs"));
+    const policy_entry_t *fifo = policy_get(policy_find("fifo"));
+    long size = ok ? ftell(f) : 0;
+    rewind(f);
+    if (ok && engine_resume(&e, &ps, fifo->ops, &fifo->report, &sink.base, f) == 0) ok = 0;
+    if (ok) {
+        fseek(f, size / 2, SEEK_SET);
+        int c = fgetc(f);
+        fseek(f, size / 2, SEEK_SET);
+        fputc(c ^ 0x10, f);
+        rewind(f);
+        if (engine_resume(&e, &ps, cfs->ops, &cfs->report, &sink.base, f) == 0) ok = 0;
+    }
+    timeline_buffer_free(&sink);
+
+    printf("Checkpoint test:\n");
+    printf("%d policies, checkpoint of %d processes is %ld bytes\n", POLICY_COUNT, n, size);
+    printf(ok ? "PASSED\n" : "FAILED\n");
+
+    if (f) fclose(f);
+    process_store_free(&ps);
+    free(processes);
+    return 0;
+}
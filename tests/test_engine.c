@@ -0,0 +1,88 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../include/scheduler.h"
+#include "../include/engine.h"
+#include "../include/policy.h"
+#include "../include/timeline.h"
+
+/* a policy defined outside algorithms.c: last come, first served, run to completion */
+typedef struct {
+    int stack[8];
+    int top;
+} lifo_state_t;
+
+static int lifo_init(void *state, process_store_t *ps, const policy_params_t *params, sim_time_t start) {
+    (void)state; (void)params; (void)start;
+    return ps->n <= 8 ? 0 : -1;
+}
+
+static void lifo_push(void *state, int idx, sim_time_t time) {
+    lifo_state_t *s = state;
+    (void)time;
+    s->stack[s->top++] = idx;
+}
+
+static int lifo_pick(void *state, sim_time_t time) {
+    lifo_state_t *s = state;
+    (void)time;
+    return s->top > 0 ? s->stack[--s->top] : -1;
+}
+
+static sim_time_t lifo_slice(void *state, int idx, sim_time_t time) {
+    (void)state; (void)idx; (void)time;
+    return SLICE_UNLIMITED;
+}
+
+static void lifo_requeue(void *state, int idx, sim_time_t ran, sim_time_t time) {
+    (void)ran;
+    lifo_push(state, idx, time);
+}
+
+static const sched_policy_t policy_lifo = {
+    "lifo", sizeof(lifo_state_t), lifo_init, NULL, lifo_push, lifo_pick, lifo_slice, NULL, NULL, lifo_requeue, NULL
+};
+
+int main() {
+    process_t processes[4] = {
+        {1,0,3,1,3,0,0,0,0},
+        {2,1,3,1,3,0,0,0,0},
+        {3,2,3,1,3,0,0,0,0},
+        {4,20,2,1,2,0,0,0,0}
+    };
+    int n = 4;
+    int ok = 1;
+    process_store_t store;
+    process_store_init(&store, processes, n);
+    timeline_buffer_t timeline;
+    timeline_buffer_init(&timeline);
+
+    // P1 0-3, P3 3-6, P2 6-9, idle 9-20, P4 20-22
+    policy_params_t params = {0};
+    if (engine_run(&store, &policy_lifo, &params, &timeline.base) != 0) ok = 0;
+    sim_time_t expected[4] = {3, 9, 6, 22};
+    for (int i = 0; i < n; ++i) if (store.cold[i].completion_time != expected[i]) ok = 0;
+    if (timeline.len != 5 || timeline.events[3].pid != -1 || timeline.events[3].duration != 11) ok = 0;
+
+    // registry: parse a command line and match it against the report configuration
+    char *rr_args[] = {"3"};
+    int slot = policy_find("rr");
+    policy_params_t rr = {0};
+    if (slot < 0 || policy_get(slot)->parse(1, rr_args, &rr) != 0 ||
+        !policy_params_equal(&rr, &policy_get(slot)->report)) ok = 0;
+    rr.quantum = 4;
+    if (policy_params_equal(&rr, &policy_get(slot)->report)) ok = 0;
+    if (policy_find("lifo") != -1) ok = 0;
+
+    printf("Engine test:\n");
+    printf("LIFO completions: %lld %lld %lld %lld\n", store.cold[0].completion_time, store.cold[1].completion_time,
+           store.cold[2].completion_time, store.cold[3].completion_time);
+    if (ok)
+        printf("PASSED\n");
+    else
+        printf("FAILED\n");
+
+    timeline_buffer_free(&timeline);
+    process_store_free(&store);
+    return 0;
+}
@@ -0,0 +1,60 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../include/scheduler.h"
+#include "../include/algorithms.h"
+#include "../include/ready_queue.h"
+#include "../include/timeline.h"
+
+int main() {
+    // P1 holds twice P2's tickets; P3 arrives late and joins at the current pass
+    process_t processes[3] = {
+        {1,0,60,1,60,0,0,0,0},
+        {2,0,60,2,60,0,0,0,0},
+        {3,30,6,1,6,0,0,0,0}
+    };
+    int n = 3;
+    int ok = 1;
+    process_store_t store;
+    process_store_init(&store, processes, n);
+    timeline_callback_t counter;
+
+    // stride, quantum 1: P1 gets 2 slices per P2 slice, so P1 ends near 60 + 30 + 6
+    timeline_callback_init(&counter, NULL, NULL);
+    schedule_stride(&store, 1, &counter.base);
+    sim_time_t p1 = store.cold[0].completion_time;
+    if (p1 < 94 || p1 > 98) ok = 0;
+    if (store.cold[1].completion_time != 126) ok = 0;
+    if (store.cold[2].completion_time > 45) ok = 0;   // newcomer is not starved
+
+    // lottery: same seed, same schedule; everything completes
+    sim_time_t first[3];
+    timeline_callback_init(&counter, NULL, NULL);
+    schedule_lottery(&store, 1, 7, &counter.base);
+    for (int i = 0; i < n; ++i) first[i] = store.cold[i].completion_time;
+    timeline_callback_init(&counter, NULL, NULL);
+    schedule_lottery(&store, 1, 7, &counter.base);
+    for (int i = 0; i < n; ++i) if (store.cold[i].completion_time != first[i] || first[i] <= 0) ok = 0;
+
+    // ticket tree: draws map to the owning index, removals drop the range
+    ticket_tree_t tt;
+    tt_init(&tt, 5);
+    tt_add(&tt, 0, 4);
+    tt_add(&tt, 2, 1);
+    tt_add(&tt, 4, 3);
+    if (tt.total != 8 || tt_find(&tt, 0) != 0 || tt_find(&tt, 3) != 0 ||
+        tt_find(&tt, 4) != 2 || tt_find(&tt, 5) != 4 || tt_find(&tt, 7) != 4) ok = 0;
+    tt_add(&tt, 2, -1);
+    if (tt.total != 7 || tt_find(&tt, 4) != 4) ok = 0;
+    tt_free(&tt);
+
+    printf("Lottery/stride test:\n");
+    printf("lottery seed 7: P1=%lld P2=%lld P3=%lld\n", first[0], first[1], first[2]);
+    if (ok)
+        printf("PASSED\n");
+    else
+        printf("FAILED\n");
+
+    process_store_free(&store);
+    return 0;
+}
@@ -0,0 +1,54 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../include/scheduler.h"
+#include "../include/metrics.h"
+#include "../include/process_store.h"
+
+int main() {
+    // 1000 processes arriving at 0, completions 1..1000 in scrambled order
+    int n = 1000;
+    process_t *processes = calloc(n, sizeof(process_t));
+    for (int i = 0; i < n; ++i) {
+        processes[i].pid = i + 1;
+        processes[i].burst_time = 1;
+    }
+    process_store_t store;
+    process_store_init(&store, processes, n);
+    for (int i = 0; i < n; ++i) {
+        store.hot[i].remaining_time = 0;
+        store.cold[i].start_time = 0;
+        store.cold[i].completion_time = (i * 7) % n + 1;
+    }
+
+    metrics_t m;
+    calculate_metrics(&store, n, &m);
+
+    // the same completions fed one by one: exact below 128, within 1% above
+    metrics_acc_t acc;
+    metrics_acc_init(&acc);
+    store.acc = &acc;
+    for (int i = 0; i < n; ++i) process_store_complete(&store, i, store.cold[i].completion_time);
+    metrics_t inc;
+    metrics_acc_snapshot(&acc, n, &inc);
+    int acc_ok = inc.avg_turnaround_time == m.avg_turnaround_time &&
+                 inc.avg_waiting_time == m.avg_waiting_time &&
+                 inc.turnaround.max == 1000 && inc.response.p99 == 0 &&
+                 inc.turnaround.p99 >= 990 && inc.turnaround.p99 <= 990 * 1.01;
+    metrics_acc_free(&acc);
+
+    printf("Metrics test:\n");
+    printf("TAT p50=%.0f p90=%.0f p99=%.0f p99.9=%.0f max=%.0f\n", m.turnaround.p50, m.turnaround.p90,
+           m.turnaround.p99, m.turnaround.p999, m.turnaround.max);
+    if (m.turnaround.p50 == 500 && m.turnaround.p90 == 900 && m.turnaround.p99 == 990 &&
+        m.turnaround.p999 == 999 && m.turnaround.max == 1000 &&
+        m.waiting.p50 == 499 && m.waiting.max == 999 &&
+        m.response.max == 0 && m.avg_turnaround_time == 500.5 && acc_ok)
+        printf("PASSED\n");
+    else
+        printf("FAILED\n");
+
+    process_store_free(&store);
+    free(processes);
+    return 0;
+}
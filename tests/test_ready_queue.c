@@ -0,0 +1,51 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../include/scheduler.h"
+#include "../include/ready_queue.h"
+
+int main() {
+    process_t processes[5] = {
+        {1,0,5,1,5,0,0,0,0},
+        {2,1,3,2,3,0,0,0,0},
+        {3,2,8,1,8,0,0,0,0},
+        {4,0,3,1,3,0,0,0,0},
+        {5,4,1,1,1,0,0,0,0}
+    };
+    int n = 5;
+    process_store_t store;
+    process_store_init(&store, processes, n);
+    ready_queue_t rq;
+    rq_init(&rq, store.hot, n, rq_cmp_burst);
+    for (int i = 0; i < n; ++i) rq_push(&rq, i);
+
+    // re-key P3 below everyone else, then drop P5
+    store.hot[2].burst_time = 0;
+    rq_update(&rq, 2);
+    rq_remove(&rq, 4);
+
+    // expected order: P3 (burst 0), P4 (burst 3, arrival 0), P2 (burst 3, arrival 1), P1
+    int expected[4] = {3, 4, 2, 1};
+    int ok = 1;
+    for (int i = 0; i < 4; ++i) {
+        int idx = rq_pop(&rq);
+        if (idx < 0 || store.hot[idx].pid != expected[i]) ok = 0;
+    }
+    if (!rq_empty(&rq)) ok = 0;
+    rq_free(&rq);
+
+    // arrival cursor keeps file order on ties
+    int *order = arrival_order(store.hot, n);
+    int expected_order[5] = {0, 3, 1, 2, 4};
+    for (int i = 0; i < n; ++i) if (order[i] != expected_order[i]) ok = 0;
+    free(order);
+    process_store_free(&store);
+
+    printf("Ready queue test:\n");
+    if (ok)
+        printf("PASSED\n");
+    else
+        printf("FAILED\n");
+
+    return 0;
+}
@@ -0,0 +1,38 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../include/replicate.h"
+
+int main() {
+    replicate_config_t cfg;
+    workload_gen_defaults(&cfg.workload);
+    cfg.workload.count = 300;
+    cfg.workload.seed = 11;
+    cfg.replications = 12;
+    for (int i = 0; i < COMPARE_NUM_ALGS; ++i) cfg.selected[i] = 1;
+
+    // the same seeds must give the same summaries whatever the thread count
+    replicate_summary_t one[COMPARE_NUM_ALGS], many[COMPARE_NUM_ALGS];
+    cfg.threads = 1;
+    int a = run_replications(&cfg, one);
+    cfg.threads = 4;
+    int b = run_replications(&cfg, many);
+
+    int ok = (a == COMPARE_NUM_ALGS && b == a);
+    for (int i = 0; ok && i < a; ++i) {
+        if (memcmp(&one[i].avg_turnaround, &many[i].avg_turnaround,
+                   sizeof(replicate_summary_t) - offsetof(replicate_summary_t, avg_turnaround)) != 0) ok = 0;
+        if (one[i].avg_turnaround.half_width <= 0) ok = 0;
+    }
+    // SJF minimizes average waiting time among non-preemptive policies
+    if (ok && one[1].avg_waiting.mean > one[0].avg_waiting.mean) ok = 0;
+
+    printf("Replicate test:\n");
+    if (ok) printf("FIFO avg WT %.2f ± %.2f, SJF avg WT %.2f ± %.2f\n", one[0].avg_waiting.mean,
+                   one[0].avg_waiting.half_width, one[1].avg_waiting.mean, one[1].avg_waiting.half_width);
+    if (ok)
+        printf("PASSED\n");
+    else
+        printf("FAILED\n");
+    return 0;
+}
@@ -0,0 +1,57 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../include/scheduler.h"
+#include "../include/algorithms.h"
+#include "../include/timeline.h"
+#include "../include/smp.h"
+
+int main() {
+    process_t processes[4] = {
+        {1,0,6,1,6,0,0,0,0},
+        {2,0,6,1,6,0,0,0,0},
+        {3,1,4,2,4,0,0,0,0},
+        {4,2,2,1,2,0,0,0,0}
+    };
+    int n = 4;
+    int ok = 1;
+    process_store_t store;
+    process_store_init(&store, processes, n);
+
+    // one core behaves exactly like the single-CPU scheduler
+    timeline_buffer_t single, smp;
+    timeline_buffer_init(&single);
+    timeline_buffer_init(&smp);
+    schedule_rr(&store, 2, &single.base);
+    sim_time_t expected[4];
+    for (int i = 0; i < n; ++i) expected[i] = store.cold[i].completion_time;
+    smp_config_t cfg = {1, SMP_RR, 2, NULL, 1};
+    smp_stats_t stats;
+    if (schedule_smp(&store, &cfg, &smp.base, &stats) != 0) ok = 0;
+    for (int i = 0; i < n; ++i) if (store.cold[i].completion_time != expected[i]) ok = 0;
+    if (smp.len != single.len || stats.aggregate_utilization != 100.0) ok = 0;
+
+    // two cores: core 0 runs P1 and P3 (busy 0..10), core 1 runs P2 and P4 (busy 0..8)
+    cfg.num_cores = 2;
+    timeline_buffer_free(&smp);
+    timeline_buffer_init(&smp);
+    if (schedule_smp(&store, &cfg, &smp.base, &stats) != 0) ok = 0;
+    sim_time_t busy = 0;
+    for (int c = 0; c < 2; ++c) busy += stats.busy[c];
+    if (busy != 18 || stats.elapsed != 10 || stats.busy[0] != 10) ok = 0;
+    for (int i = 0; i < smp.len; ++i) if (smp.events[i].core < 0 || smp.events[i].core > 1) ok = 0;
+    for (int i = 0; i < n; ++i) if (!store.cold[i].finished) ok = 0;
+
+    printf("SMP test:\n");
+    printf("2 cores: elapsed=%lld util=%.2f migrations=%lld imbalance=%.3f\n",
+           stats.elapsed, stats.aggregate_utilization, stats.migrations, stats.imbalance);
+    if (ok)
+        printf("PASSED\n");
+    else
+        printf("FAILED\n");
+
+    process_store_free(&store);
+    timeline_buffer_free(&single);
+    timeline_buffer_free(&smp);
+    return 0;
+}
@@ -0,0 +1,55 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../include/scheduler.h"
+#include "../include/algorithms.h"
+#include "../include/timeline.h"
+
+int main() {
+    process_t processes[2] = {
+        {1,0,7,1,7,0,0,0,0},
+        {2,10,2,1,2,0,0,0,0}
+    };
+    int n = 2;
+    int quantum = 2;
+    process_store_t store;
+    process_store_init(&store, processes, n);
+
+    // RR slices P1 four times in a row; coalesced they become one event
+    timeline_buffer_t raw, merged;
+    timeline_buffer_init(&raw);
+    timeline_buffer_init(&merged);
+    schedule_rr(&store,quantum,&raw.base);
+
+    timeline_coalesce_t co;
+    timeline_coalesce_init(&co, &merged.base);
+    schedule_rr(&store,quantum,&co.base);
+
+    // a downstream that lost an event fails the chain, and nothing more is counted
+    timeline_buffer_t failing;
+    timeline_buffer_init(&failing);
+    failing.base.error = 1;
+    timeline_coalesce_t head;
+    timeline_coalesce_init(&head, &failing.base);
+    schedule_rr(&store,quantum,&head.base);
+    timeline_flush(&head.base);
+
+    printf("Timeline test:\n");
+    printf("raw=%zu events, coalesced=%zu events\n", raw.len, merged.len);
+    // raw: P1 x4, idle, P2; coalesced: P1, idle, P2
+    if (raw.len == 6 && merged.len == 3 &&
+        merged.events[0].pid == 1 && merged.events[0].duration == 7 &&
+        merged.events[1].pid == -1 && merged.events[1].duration == 3 &&
+        co.base.total_time == raw.base.total_time &&
+        merged.base.total_time == compute_total_time(raw.events, raw.len) &&
+        head.base.error && failing.len == 0 && failing.base.events == 0 && failing.base.total_time == 0)
+        printf("PASSED\n");
+    else
+        printf("FAILED\n");
+
+    process_store_free(&store);
+    timeline_buffer_free(&raw);
+    timeline_buffer_free(&merged);
+    timeline_buffer_free(&failing);
+    return 0;
+}